@@ -0,0 +1,72 @@
+/***********************************************************************
+ @copyright     : Siemens AG
+ @license       : GPLv3
+ @author        : Andreas Kaeberlein
+ @address       : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+
+ @maintainer    : Andreas Kaeberlein
+ @telephone     : +49 371 4810-2108
+ @email         : andreas.kaeberlein@siemens.com
+
+ @file          : pciids_main.c
+ @date          : 2026-10-18
+ @see           : https://github.com/andkae/pciinfo
+
+ @brief         : pciids
+                  compiles the text pci.ids into the memory mappable
+                  name database of the pciinfo.h library
+***********************************************************************/
+
+
+
+/** Standard libs **/
+#include <stdio.h>          // f.e. printf
+#include <stdlib.h>         // EXIT_SUCCESS
+#include <stdint.h>         // defines fiexd data types, like int8_t...
+
+
+/** User Libs **/
+#include "pciinfo.h"
+
+
+
+/**
+ *  @brief main
+ *
+ *  pciids [<pci.ids> [<pci.ids.bin>]]
+ *
+ *  @return         int             exit state of function
+ *  @since          October 18, 2026
+ */
+int main (int argc, char *argv[])
+{
+    /** variables **/
+    const char  *idsFile = PCIINFO_NAMES_IDS;   // text database
+    const char  *dbFile = PCIINFO_NAMES_DB;     // compiled database
+    int         intEntries;                     // compiled entries
+
+
+    /* Parse CLI */
+    if ( (argc > 3) || ((argc > 1) && ('-' == argv[1][0])) ) {
+        printf("Usage:\n");
+        printf("  %s [<pci.ids> {%s} [<pci.ids.bin> {%s}]]\n", argv[0], PCIINFO_NAMES_IDS, PCIINFO_NAMES_DB);
+        exit(EXIT_FAILURE);
+    }
+    if ( argc > 1 ) {
+        idsFile = argv[1];
+    }
+    if ( argc > 2 ) {
+        dbFile = argv[2];
+    }
+
+    /* compile */
+    intEntries = pciinfoNamesCompile(idsFile, dbFile);
+    if ( 0 > intEntries ) {
+        printf("[ FAIL ]   compile '%s' to '%s'\n", idsFile, dbFile);
+        exit(EXIT_FAILURE);
+    }
+    printf("[ OKAY ]   compiled %d entries of '%s' to '%s'\n", intEntries, idsFile, dbFile);
+
+    /* gracefull end */
+    exit(EXIT_SUCCESS);
+};
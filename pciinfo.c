@@ -22,11 +22,24 @@
 /** Includes **/
 /* Standard libs */
 #include <stdint.h>   /* defines fixed data types, like int8_t... */
+#include <inttypes.h> /* SCNu64 */
 #include <stdio.h>    /* e.g. snprintf */
 #include <stdlib.h>   /* defines functions for performing general operations, f.e.
                        * strtol */
 #include <string.h>   /* string handling functions */
 #include <strings.h>  /* for function strcasecmp */
+#include <limits.h>   /* PATH_MAX */
+#include <ctype.h>    /* isxdigit */
+#include <dirent.h>   /* opendir, readdir */
+#include <errno.h>    /* errno */
+#include <fcntl.h>    /* open */
+#include <unistd.h>   /* write, readlink */
+#include <time.h>     /* clock_gettime */
+#include <sys/mman.h> /* mmap */
+#include <sys/stat.h> /* fstat */
+#include <pthread.h>  /* trace writer thread */
+#include <stdatomic.h>  /* lock-free ring buffer */
+#include <sys/syscall.h>    /* SYS_mbind */
 
 /* User libs */
 #include "pciinfo.h"  /* function prototypes */
@@ -50,279 +63,2927 @@
 
 
 
+/**
+ *  @defgroup PCIINFO_MPOL
+ *
+ *  memory policy of mbind, numaif.h belongs to libnuma
+ *
+ *  @{
+ */
+#define PCIINFO_MPOL_BIND       2       /**< MPOL_BIND */
+#define PCIINFO_MPOL_MF_STRICT  1       /**< MPOL_MF_STRICT */
+#define PCIINFO_NUMA_MAX        1024    /**< maximum number of NUMA nodes */
+/** @} */   // PCIINFO_MPOL
+
+
+
+/**
+ *  @brief  sysfs root
+ *
+ *  mount point of sysfs, changeable with pciinfoSysRoot
+ */
+static char g_pciinfoSysRoot[PCIINFO_PATH_MAX] = PCIINFO_SYS_ROOT;
+
+
+
+/**
+ *  @brief  procfs root
+ *
+ *  mount point of procfs, changeable with pciinfoProcRoot
+ */
+static char g_pciinfoProcRoot[PCIINFO_PATH_MAX] = PCIINFO_PROC_ROOT;
+
+
+
+/**
+ *  @defgroup PCIINFO_NAMES
+ *
+ *  compiled PCI id database, native byte order
+ *
+ *    header | entry[slots] | string blob
+ *
+ *  entries are placed by hash of the key with linear probing,
+ *  'kind' of zero marks a free slot.
+ *
+ *  @{
+ */
+#define PCIINFO_NAMES_MAGIC     "PCIIDB01"  /**< file identification and format version */
+#define PCIINFO_NAMES_VENDOR    1           /**< entry is vendor */
+#define PCIINFO_NAMES_DEVICE    2           /**< entry is device */
+#define PCIINFO_NAMES_SUBSYS    3           /**< entry is subsystem */
+
+typedef struct t_pciinfo_names_hdr {
+    char        magic[8];   /**< PCIINFO_NAMES_MAGIC */
+    uint32_t    slots;      /**< hash table size, power of two */
+    uint32_t    entries;    /**< used hash table slots */
+    uint32_t    strSize;    /**< size of string blob */
+    uint32_t    rsv;        /**< reserved */
+} t_pciinfo_names_hdr;
+
+typedef struct t_pciinfo_names_ent {
+    uint16_t    vendor;     /**< vendor id */
+    uint16_t    device;     /**< device id */
+    uint16_t    subVendor;  /**< subsystem vendor id */
+    uint16_t    subDevice;  /**< subsystem device id */
+    uint32_t    kind;       /**< PCIINFO_NAMES_VENDOR/DEVICE/SUBSYS, 0 if slot free */
+    uint32_t    str;        /**< offset of name in string blob */
+} t_pciinfo_names_ent;
+/** @} */   // PCIINFO_NAMES
+
+
+
+/**
+ *  @brief  memory mapped PCI id database
+ */
+static const uint8_t    *g_pciinfoNames = NULL;
+static size_t           g_pciinfoNamesSize = 0;
+
+
+
+/**
+ *  @brief  sample ring buffer
+ *
+ *  single producer (sampler) single consumer (trace writer), 'head' and
+ *  'tail' count free running, the index is masked with the ring size
+ */
+typedef struct t_pciinfo_ring {
+    t_pciinfo_sample    buf[PCIINFO_WATCH_RING];    /**< samples */
+    _Atomic uint64_t    head;                       /**< written by producer */
+    _Atomic uint64_t    tail;                       /**< written by consumer */
+    atomic_int          done;                       /**< producer finished */
+    FILE                *trace;                     /**< trace file */
+    int                 err;                        /**< write error of consumer */
+} t_pciinfo_ring;
+
+
+
+/**
+ *  @brief  fan-out work queue
+ *
+ *  shared by all workers, 'next' hands out the card indices
+ */
+typedef struct t_pciinfo_pool {
+    t_pciinfo_card      *card;      /**< cards in BDF order */
+    uint32_t            num;        /**< number of cards */
+    _Atomic uint32_t    next;       /**< next unprocessed card */
+    uint8_t             barMask;    /**< BARs to map */
+    int                 writeable;  /**< BAR mapping mode */
+    t_pciinfo_fanout_fn fn;         /**< callback */
+    void                *arg;       /**< user argument */
+} t_pciinfo_pool;
+
+
+
+/**
+ *  pciinfo_is_bdf
+ *    checks for 'DDDD:BB:DD.F' format, domain could be wider than four digits
+ */
+static int pciinfo_is_bdf(const char str[])
+{
+    size_t  len = strlen(str);
+
+    /* check for separators */
+    if ( (len < 12) || ('.' != str[len-2]) || (':' != str[len-5]) || (':' != str[len-8]) ) {
+        return 0;
+    }
+    /* check for digits */
+    for ( size_t i = 0; i < len; i++ ) {
+        if ( (i == len-2) || (i == len-5) || (i == len-8) ) {
+            continue;
+        }
+        if ( 0 == isxdigit((unsigned char) str[i]) ) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+
+/**
+ *  pciinfo_is_root
+ *    checks for root complex 'pciDDDD:BB'
+ */
+static int pciinfo_is_root(const char str[])
+{
+    const char  *sep;
+
+    if ( 0 != strncmp(str, "pci", 3) ) {
+        return 0;
+    }
+    sep = strchr(str + 3, ':');
+    if ( (NULL == sep) || (sep == (str + 3)) || ('\0' == sep[1]) ) {
+        return 0;
+    }
+    for ( const char *c = str + 3; '\0' != *c; c++ ) {
+        if ( (c != sep) && (0 == isxdigit((unsigned char) *c)) ) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+
+
+/**
+ *  pciinfo_dev_path
+ *    builds system path from BDF, paths are taken as they are
+ */
+static int pciinfo_dev_path(const char dev[], char path[], size_t pathMax)
+{
+    int intLen;
+
+    if ( NULL != strchr(dev, '/') ) {
+        intLen = snprintf(path, pathMax, "%s", dev);
+    } else {
+        intLen = snprintf(path, pathMax, "%s/bus/pci/devices/%s", g_pciinfoSysRoot, dev);
+    }
+    if ( (intLen < 0) || ((size_t) intLen >= pathMax) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    return 0;
+}
+
+
+
+/**
+ *  pciinfo_sysfs_read
+ *    reads first line of sysfs attribute, line break is removed
+ */
+static int pciinfo_sysfs_read(const char sysPathPciDev[], const char attr[], char val[],
+                              size_t valMax)
+{
+    char    charPath[PCIINFO_PATH_MAX + 64];
+    FILE    *fptr;
+
+    /* build path */
+    val[0] = '\0';
+    if ( (size_t) snprintf(charPath, sizeof(charPath), "%s/%s", sysPathPciDev, attr) >= sizeof(charPath) ) {
+        return -1;
+    }
+    /* read */
+    fptr = fopen(charPath, "r");
+    if ( NULL == fptr ) {
+        return -1;
+    }
+    if ( NULL == fgets(val, (int) valMax, fptr) ) {
+        val[0] = '\0';
+        fclose(fptr);
+        return -1;
+    }
+    fclose(fptr);
+    val[strcspn(val, "\n")] = '\0';
+    return 0;
+}
+
+
+
+/**
+ *  pciinfo_sysfs_store
+ *    writes value to sysfs attribute with additional open flags,
+ *    returns 0 or negative errno
+ */
+static int pciinfo_sysfs_store(const char path[], const char val[], int flags)
+{
+    int     fd;
+    ssize_t len;
+
+    fd = open(path, O_WRONLY | flags);
+    if ( 0 > fd ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, path);
+        return -errno;
+    }
+    len = write(fd, val, strlen(val));
+    if ( (0 > len) || ((size_t) len != strlen(val)) ) {
+        len = (0 > len) ? -errno : -EIO;
+        pciinfo_printf("  ERROR:%s: failed to write '%s' to '%s'.\n", __FUNCTION__, val, path);
+        close(fd);
+        return (int) len;
+    }
+    if ( 0 != close(fd) ) {
+        return -errno;
+    }
+    return 0;
+}
+
+
+
+/**
+ *  pciinfo_sysfs_write
+ *    writes value to sysfs attribute, returns 0 or negative errno
+ */
+static int pciinfo_sysfs_write(const char path[], const char val[])
+{
+    return pciinfo_sysfs_store(path, val, 0);
+}
+
+
+
+/**
+ *  pciinfo_link_name
+ *    last path element of symbolic link target, f.e. driver name
+ */
+static int pciinfo_link_name(const char sysPathPciDev[], const char attr[], char name[],
+                             size_t nameMax)
+{
+    char    charPath[PCIINFO_PATH_MAX + 64];
+    char    charLink[PATH_MAX];
+    char    *base;
+    ssize_t len;
+
+    name[0] = '\0';
+    if ( (size_t) snprintf(charPath, sizeof(charPath), "%s/%s", sysPathPciDev, attr) >= sizeof(charPath) ) {
+        return -1;
+    }
+    len = readlink(charPath, charLink, sizeof(charLink) - 1);
+    if ( 0 > len ) {
+        return -1;
+    }
+    charLink[len] = '\0';
+    base = strrchr(charLink, '/');
+    base = (NULL == base) ? charLink : base + 1;
+    if ( strlen(base) >= nameMax ) {
+        return -1;
+    }
+    strcpy(name, base);
+    return 0;
+}
+
+
+
+/**
+ *  pciinfo_ns
+ *    monotonic time stamp in nanoseconds
+ */
+static uint64_t pciinfo_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t) ts.tv_sec * 1000000000ULL) + (uint64_t) ts.tv_nsec;
+}
+
+
+
+/**
+ *  pciinfo_chain
+ *    splits canonical device path into root complex and bridges,
+ *    last element is the device itself
+ *
+ *    /sys/devices/pci0000:00/0000:00:01.0/0000:01:00.0
+ *      -> pci0000:00, 0000:00:01.0, 0000:01:00.0
+ */
+static int pciinfo_chain(const char canPath[], char chain[][PCIINFO_BDF_MAX], uint32_t chainMax)
+{
+    char        charPath[PATH_MAX];
+    char        charRoot[PATH_MAX];
+    char        *tok;
+    char        *save;
+    size_t      pfxLen = 0;
+    uint32_t    len = 0;
+
+    /* strip '<sysroot>/devices/', directories above could look like a root complex */
+    if ( (NULL != realpath(g_pciinfoSysRoot, charRoot)) && ((strlen(charRoot) + sizeof("/devices/")) <= sizeof(charRoot)) ) {
+        strcat(charRoot, "/devices/");
+        if ( 0 == strncmp(canPath, charRoot, strlen(charRoot)) ) {
+            pfxLen = strlen(charRoot);
+        }
+    }
+    /* tokenize */
+    strncpy(charPath, canPath + pfxLen, sizeof(charPath) - 1);
+    charPath[sizeof(charPath) - 1] = '\0';
+    for ( tok = strtok_r(charPath, "/", &save); NULL != tok; tok = strtok_r(NULL, "/", &save) ) {
+        /* root complex starts the chain */
+        if ( (0 == len) && (0 == pciinfo_is_root(tok)) ) {
+            continue;
+        }
+        if ( (0 != len) && (0 == pciinfo_is_bdf(tok)) ) {
+            continue;
+        }
+        if ( (len >= chainMax) || (strlen(tok) >= PCIINFO_BDF_MAX) ) {
+            pciinfo_printf("  ERROR:%s: Not enough memory for '%s'\n", __FUNCTION__, canPath);
+            return -1;
+        }
+        strcpy(chain[len++], tok);
+    }
+    /* at least root complex and device */
+    if ( len < 2 ) {
+        pciinfo_printf("  ERROR:%s: '%s' is no PCI device\n", __FUNCTION__, canPath);
+        return -1;
+    }
+    return (int) len;
+}
+
+
+
+/**
+ *  pciinfo_dev_cmp
+ *    qsort/bsearch compare, sort in BDF order
+ */
+static int pciinfo_dev_cmp(const void *a, const void *b)
+{
+    return strcmp(((const t_pciinfo_dev*) a)->bdf, ((const t_pciinfo_dev*) b)->bdf);
+}
+
+
+
+/**
+ *  pciinfo_match_dev
+ *    checks device against filter
+ */
+static int pciinfo_match_dev(const t_pciinfo_match *match, const t_pciinfo_dev *dev)
+{
+    if ( NULL == match ) {
+        return 1;
+    }
+    if ( ('\0' != match->vendorID[0]) && (strtoul(match->vendorID, NULL, 16) != dev->vendor) ) {
+        return 0;
+    }
+    if ( ('\0' != match->deviceID[0]) && (strtoul(match->deviceID, NULL, 16) != dev->device) ) {
+        return 0;
+    }
+    if ( 0 != strncasecmp(match->bdf, dev->bdf, strlen(match->bdf)) ) {
+        return 0;
+    }
+    return 1;
+}
+
+
+
+/**
+ *  pciinfo_enum
+ *    enumerates PCI devices in sysfs which pass the filter, sorted in BDF order
+ */
+static int pciinfo_enum(const t_pciinfo_match *match, t_pciinfo_dev dev[], uint32_t devMax)
+{
+    char            charPath[PCIINFO_PATH_MAX];
+    char            charCan[PATH_MAX];
+    char            charVal[64];
+    t_pciinfo_dev   devTmp;
+    uint32_t        num = 0;
+    DIR             *dir;
+    struct dirent   *ent;
+
+    /* open device directory */
+    if ( (size_t) snprintf(charPath, sizeof(charPath), "%s/bus/pci/devices", g_pciinfoSysRoot) >= sizeof(charPath) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    dir = opendir(charPath);
+    if ( NULL == dir ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, charPath);
+        return -1;
+    }
+    /* collect devices */
+    while ( NULL != (ent = readdir(dir)) ) {
+        if ( 0 == pciinfo_is_bdf(ent->d_name) ) {
+            continue;
+        }
+        if ( (0 != pciinfo_dev_path(ent->d_name, charPath, sizeof(charPath))) ||
+             (NULL == realpath(charPath, charCan)) ||
+             (strlen(charCan) >= sizeof(dev[0].path)) ) {
+            pciinfo_printf("  ERROR:%s: failed to resolve '%s'.\n", __FUNCTION__, ent->d_name);
+            continue;
+        }
+        memset(&devTmp, 0, sizeof(devTmp));
+        strncpy(devTmp.bdf, ent->d_name, sizeof(devTmp.bdf) - 1);
+        strcpy(devTmp.path, charCan);
+        if ( 0 == pciinfo_sysfs_read(charCan, "vendor", charVal, sizeof(charVal)) ) {
+            devTmp.vendor = (uint16_t) strtoul(charVal, NULL, 16);
+        }
+        if ( 0 == pciinfo_sysfs_read(charCan, "device", charVal, sizeof(charVal)) ) {
+            devTmp.device = (uint16_t) strtoul(charVal, NULL, 16);
+        }
+        if ( 0 == pciinfo_sysfs_read(charCan, "subsystem_vendor", charVal, sizeof(charVal)) ) {
+            devTmp.subVendor = (uint16_t) strtoul(charVal, NULL, 16);
+        }
+        if ( 0 == pciinfo_sysfs_read(charCan, "subsystem_device", charVal, sizeof(charVal)) ) {
+            devTmp.subDevice = (uint16_t) strtoul(charVal, NULL, 16);
+        }
+        if ( 0 == pciinfo_sysfs_read(charCan, "class", charVal, sizeof(charVal)) ) {
+            devTmp.class = (uint32_t) strtoul(charVal, NULL, 16);
+        }
+        devTmp.parent = -1;
+        if ( 0 == pciinfo_match_dev(match, &devTmp) ) {
+            continue;
+        }
+        /* store match */
+        if ( num >= devMax ) {
+            pciinfo_printf("  ERROR:%s: Not enough memory, more than %u devices\n", __FUNCTION__, devMax);
+            closedir(dir);
+            return -1;
+        }
+        dev[num] = devTmp;
+        ++num;
+    }
+    closedir(dir);
+    /* BDF order */
+    qsort(dev, num, sizeof(dev[0]), pciinfo_dev_cmp);
+    return (int) num;
+}
+
+
+
+/**
+ *  pciinfo_names_slot
+ *    start slot of key in hash table
+ */
+static uint32_t pciinfo_names_slot(uint32_t kind, uint16_t vendor, uint16_t device,
+                                   uint16_t subVendor, uint16_t subDevice, uint32_t slots)
+{
+    uint64_t    key;
+
+    /* 64bit mix (murmur3 finalizer) */
+    key = ((uint64_t) vendor << 48) | ((uint64_t) device << 32) | ((uint64_t) subVendor << 16) | subDevice;
+    key ^= (uint64_t) kind * 0x9E3779B97F4A7C15ULL;
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ULL;
+    key ^= key >> 33;
+    return (uint32_t) key & (slots - 1);
+}
+
+
+
+/**
+ *  pciinfo_names_get
+ *    lookup of key in memory mapped database
+ */
+static const char* pciinfo_names_get(uint32_t kind, uint16_t vendor, uint16_t device,
+                                     uint16_t subVendor, uint16_t subDevice)
+{
+    const t_pciinfo_names_hdr   *hdr;
+    const t_pciinfo_names_ent   *ent;
+    const char                  *str;
+    uint32_t                    slot;
+
+    /* database open? */
+    if ( NULL == g_pciinfoNames ) {
+        return NULL;
+    }
+    hdr = (const t_pciinfo_names_hdr*) g_pciinfoNames;
+    ent = (const t_pciinfo_names_ent*) (g_pciinfoNames + sizeof(*hdr));
+    str = (const char*) (ent + hdr->slots);
+    /* probe until free slot */
+    slot = pciinfo_names_slot(kind, vendor, device, subVendor, subDevice, hdr->slots);
+    for ( uint32_t i = 0; i < hdr->slots; i++ ) {
+        if ( 0 == ent[slot].kind ) {
+            break;
+        }
+        if ( (kind == ent[slot].kind) && (vendor == ent[slot].vendor) && (device == ent[slot].device) &&
+             (subVendor == ent[slot].subVendor) && (subDevice == ent[slot].subDevice) ) {
+            /* name inside blob, terminated blob keeps every name terminated */
+            if ( ent[slot].str >= hdr->strSize ) {
+                pciinfo_printf("  ERROR:%s: slot %u points outside names\n", __FUNCTION__, slot);
+                return NULL;
+            }
+            return str + ent[slot].str;
+        }
+        slot = (slot + 1) & (hdr->slots - 1);
+    }
+    return NULL;
+}
+
+
+
+/**
+ *  pciinfoSysRoot
+ *    set sysfs mount point
+ */
+int pciinfoSysRoot(const char sysRoot[])
+{
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* restore default */
+    if ( NULL == sysRoot ) {
+        sysRoot = PCIINFO_SYS_ROOT;
+    }
+    /* check for enough memory */
+    if ( strlen(sysRoot) >= sizeof(g_pciinfoSysRoot) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    strcpy(g_pciinfoSysRoot, sysRoot);
+    return 0;
+}
+
+
+
+/**
+ *  pciinfoProcRoot
+ *    set procfs mount point
+ */
+int pciinfoProcRoot(const char procRoot[])
+{
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* restore default */
+    if ( NULL == procRoot ) {
+        procRoot = PCIINFO_PROC_ROOT;
+    }
+    /* check for enough memory */
+    if ( strlen(procRoot) >= sizeof(g_pciinfoProcRoot) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    strcpy(g_pciinfoProcRoot, procRoot);
+    return 0;
+}
+
+
+
 /**
  *  pciinfoFind
  *    finds linux system path based on provided vendor and device id
  */
-int pciinfoFind(const char vendorID[], const char deviceID[], char devicePath[],
-                uint32_t devicePathMax)
+int pciinfoFind(const char vendorID[], const char deviceID[], char devicePath[],
+                uint32_t devicePathMax)
+{
+    /** used variables **/
+    char     cmd[PCIINFO_PATH_MAX+64]; /* command buffer */
+    char     devPath[256];             /* path buffer */
+    char     line1[1024], line2[1024]; /* read buffer */
+    uint16_t uint16DevPathIdx;         /* match with buff */
+    uint8_t  uint8FoundDevice;         /* device found */
+    FILE     *foundVendor;             /* system call answer */
+    FILE     *foundDevice;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* search in system path for pci devices*/
+    if ( (size_t) snprintf(cmd, sizeof(cmd), "grep -irnw %s/bus/pci/devices/*/vendor -e %s", g_pciinfoSysRoot, vendorID) >= sizeof(cmd) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    foundVendor = popen(cmd, "r");
+
+    /* process found device list for device ID */
+    uint8FoundDevice = 0;
+    while (EOF != fscanf(foundVendor, "%s", line1)) {
+        /*  extract device path for given vendor id
+         *  before: /sys/bus/pci/devices/0000:03:0d.0/vendor:1:0x110a
+         *  after:  /sys/bus/pci/devices/0000:03:0d.0
+         */
+        if ( (strstr(line1, "/vendor") - line1) <
+            ((int)(sizeof(devPath) / sizeof(devPath[0]))) ) {
+            uint16DevPathIdx = (uint16_t)(strstr(line1, "/vendor") - line1);
+        } else {
+            uint16DevPathIdx = 0;
+            pciinfo_printf("Not enough memory to store PCI device path...\n");
+        }
+        strncpy(devPath, line1, uint16DevPathIdx);
+        devPath[uint16DevPathIdx] = '\0';    /* termination character */
+
+        /*  build command for device id look up
+         *  cat /sys/bus/pci/devices/0000:03:0d.0/device
+         */
+        strcpy(cmd, "cat ");
+        strcat(cmd, devPath);
+        strcat(cmd, "/device");
+        foundDevice = popen(cmd, "r");
+
+        /* process system call response */
+        if ( fscanf(foundDevice, "%s", line2) ) {    /* read only first line */
+        }
+        if (0 == strcasecmp(line2, deviceID)) {
+            ++uint8FoundDevice;    /* increment match counter */
+            strncpy(devicePath, devPath, devicePathMax);
+            pciinfo_printf("vendor=%s/device=%s in '%s'\n", vendorID, line2, devPath);
+        }
+
+        /* close opened pipe */
+        pclose(foundDevice);
+    }
+
+    /* close opened pipe */
+    pclose(foundVendor);
+
+    /* finish function */
+    return (uint8FoundDevice - 1);
+}
+
+
+
+/**
+ *  pciinfoBarExist
+ *    check if bar is present
+ */
+int pciinfoBarExist(const char sysPathPciDev[])
+{
+    /** variables **/
+    int     intRet = 0;         // bit index indicates bar present y/n
+    char    charCmd[2048];      // string for buffering command
+    char    charResult[1024];   // command result one file line
+    FILE    *cmdResult;         // stored command result
+
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* iterate over 6 possible bars */
+    for ( uint8_t i = 0; i < 6; i++ ) {
+        /*
+         *  build system call request for bar size
+         *    ls /sys/bus/pci/devices/0000:03:0d.0/resource*
+         */
+        snprintf(charCmd, sizeof(charCmd), "ls %s/resource%d 2>/dev/null", sysPathPciDev, i);
+        /* help message */
+        pciinfo_printf("  INFO:%s:BAR%d:CMD: %s\n", __FUNCTION__, i, charCmd);
+        /* execute command */
+        cmdResult = popen(charCmd, "r");
+        /* parse result */
+        while (EOF != fscanf(cmdResult, "%s", charResult)) {
+            /* debug */
+            pciinfo_printf("  INFO:%s:BAR%d:RESULT: %s\n", __FUNCTION__, i, charResult);
+            /* check length */
+            if ( 0 < strlen(charResult) ) {
+                intRet |= (int) (1<<i);     // bar is present
+            }
+        }
+        /* close file handle */
+        pclose(cmdResult);
+    }
+    /* return */
+    return intRet;
+}
+
+
+
+/**
+ *  pciinfoBarSize
+ *    gets bar size from linux
+ */
+int pciinfoBarSize(const char sysPathPciDev[], uint8_t bar, uint32_t *byteSize)
+{
+
+    /** used variables **/
+    char        charCmd[1024];              // string for buffering command
+    char        resultLine[1024];           // command result one file line
+    uint32_t    i;                          // iterator
+    FILE        *cmdResult;                 // stored command result
+
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* check argument */
+    if ( bar > 5 ) {
+        pciinfo_printf("  ERROR:%s: Bar=%i exceeds max of 5\n", __FUNCTION__, bar);
+        return -1;
+    }
+
+    /* init */
+    *byteSize = 0;
+    charCmd[0] = '\0';
+
+    /*  build system call request for bar size
+     *  ls -la /sys/bus/pci/devices/0000:03:0d.0/resource*
+     */
+    snprintf(charCmd, sizeof(charCmd), "ls -la %s/resource%d 2>/dev/null", sysPathPciDev, bar);
+
+    /* execute command */
+    cmdResult = popen(charCmd, "r");
+
+    /* process acquired data */
+    i = 0;
+    while (EOF != fscanf(cmdResult, "%s", resultLine)) {
+        /*  get fifth element in table, is file size
+         *  -rw------- 1 root root 32768 Feb 11 11:40 /sys/bus/pci/devices/0000:03:0d.0/resource0
+         */
+        if (4 == i) {
+            *byteSize = (uint32_t) strtol(resultLine, NULL, 10);
+            break;  // no further processing of string required after size extaction
+        }
+        ++i;    // increment counter
+    }
+
+    /* close file handle */
+    pclose(cmdResult);
+
+    /* finish function */
+    return 0;
+}
+
+
+
+/**
+ *  pciinfoBarPath
+ *  --------------
+ */
+int pciinfoBarPath(const char vendorID[], const char deviceID[], uint8_t bar,
+                   char devicePath[], uint32_t devicePathMax)
+{
+    /** used variables **/
+    char    charBar[5];
+    FILE    *fptr;      // pointer to file
+
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* find pci device */
+    devicePath[0] = '\0';
+    if (0 != pciinfoFind(vendorID, deviceID, devicePath, devicePathMax)) {
+        pciinfo_printf  (   "  ERROR:%s: Unable to find PCI Device with VendorID=%s and DeviceID=%s\n",
+                            __FUNCTION__, vendorID, deviceID
+                        );
+        return -1;
+    }
+
+    /* build final path */
+    charBar[0] = '\0';
+    sprintf(charBar, "%d", bar);
+    strncat(devicePath, "/resource", (size_t) devicePathMax-1);
+    strncat(devicePath, charBar, (size_t) devicePathMax-1);
+
+    /*  check if file could be open */
+    fptr = fopen(devicePath, "r");
+    if (NULL == fptr) {
+        pciinfo_printf  (  "  ERROR:%s: File '%s' not found\n",
+                           __FUNCTION__, devicePath
+                        );
+        devicePath[0] = '\0';   // make invalid
+        return -1;              // failed
+    }
+    fclose(fptr);   // close
+
+    /* finish function */
+    return 0;
+}
+
+
+
+/**
+ *  pciinfoBarPhyAdr
+ *    get physical address of PCI bar
+ */
+int pciinfoBarPhyAdr(const char sysPathPciDev[], uint8_t barNo,
+                      uint32_t *barPhyAddr)
+{
+    /** used variables **/
+    char    sysPathTemp[1024] = {'\0'}; /* temporary buffer variable */
+    char    line[1023];                 /* read buffer */
+    uint8_t index;
+    FILE    *fptr;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+    pciinfo_printf("  INFO:%s:DEVICE: '%s'.\n", __FUNCTION__, sysPathPciDev);
+
+    /* check for enough memory */
+    if ( (strlen(sysPathPciDev) + 10) > sizeof(sysPathTemp) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+
+    /*  build path to bar
+    *  before: /sys/bus/pci/devices/0000:04:0d.0/
+    *  after:  /sys/bus/pci/devices/0000:04:0d.0/resource
+    */
+    strncpy(sysPathTemp, sysPathPciDev, sizeof(sysPathTemp));
+    strncat(sysPathTemp, "/resource",  sizeof(sysPathTemp)-1);
+
+    /* open file handle */
+    fptr = fopen(sysPathTemp, "r");
+    if (NULL == fptr) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, sysPathTemp);
+        return -1;
+    }
+
+    /* iterate over all possible pci bars */
+    /* line number is the bar number */
+    for (index = 0; index < barNo; index++) {
+        if (NULL == fgets(line, sizeof(line), fptr)) {
+            pciinfo_printf("  ERROR:%s: bar %i not resent\n", __FUNCTION__, barNo);
+            fclose(fptr);
+            return -1;
+        }
+    }
+    /* first column is the starting address of the bar */
+    if ( fscanf(fptr, "%x", barPhyAddr) ) {
+    }
+
+    /* close opened pipe */
+    fclose(fptr);
+
+    /* finish function */
+    return 0;
+}
+
+
+
+/**
+ *  pciinfoTopo
+ *    builds parent/child tree of all PCI devices
+ */
+int pciinfoTopo(t_pciinfo_dev dev[], uint32_t devMax)
+{
+    /** used variables **/
+    char            chain[PCIINFO_TREE_DEPTH][PCIINFO_BDF_MAX];
+    int             intNum;
+    int             intLen;
+    t_pciinfo_dev   key;
+    t_pciinfo_dev   *parent;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* collect devices */
+    intNum = pciinfo_enum(NULL, dev, devMax);
+    if ( intNum < 0 ) {
+        return -1;
+    }
+    /* resolve upstream bridge */
+    for ( int i = 0; i < intNum; i++ ) {
+        intLen = pciinfo_chain(dev[i].path, chain, PCIINFO_TREE_DEPTH);
+        if ( intLen < 0 ) {
+            continue;
+        }
+        strcpy(dev[i].host, chain[0]);
+        dev[i].depth = (uint8_t) (intLen - 2);
+        if ( 2 == intLen ) {    // attached to root complex
+            continue;
+        }
+        strcpy(key.bdf, chain[intLen - 2]);
+        parent = bsearch(&key, dev, (size_t) intNum, sizeof(dev[0]), pciinfo_dev_cmp);
+        if ( NULL != parent ) {
+            dev[i].parent = (int32_t) (parent - dev);
+        }
+        pciinfo_printf("  INFO:%s: %s -> %s\n", __FUNCTION__, dev[i].bdf, chain[intLen - 2]);
+    }
+    /* finish function */
+    return intNum;
+}
+
+
+
+/**
+ *  pciinfoDistance
+ *    hop count between two PCI devices
+ */
+int pciinfoDistance(const char devA[], const char devB[], char ancestor[],
+                    uint32_t ancestorMax)
+{
+    /** used variables **/
+    char    charPath[PCIINFO_PATH_MAX];
+    char    charCan[PATH_MAX];
+    char    chainA[PCIINFO_TREE_DEPTH][PCIINFO_BDF_MAX];
+    char    chainB[PCIINFO_TREE_DEPTH][PCIINFO_BDF_MAX];
+    int     intLenA, intLenB;
+    int     intCommon;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* resolve canonical path of both devices */
+    if ( (0 != pciinfo_dev_path(devA, charPath, sizeof(charPath))) || (NULL == realpath(charPath, charCan)) ) {
+        pciinfo_printf("  ERROR:%s: failed to resolve '%s'.\n", __FUNCTION__, devA);
+        return -1;
+    }
+    intLenA = pciinfo_chain(charCan, chainA, PCIINFO_TREE_DEPTH);
+    if ( (0 != pciinfo_dev_path(devB, charPath, sizeof(charPath))) || (NULL == realpath(charPath, charCan)) ) {
+        pciinfo_printf("  ERROR:%s: failed to resolve '%s'.\n", __FUNCTION__, devB);
+        return -1;
+    }
+    intLenB = pciinfo_chain(charCan, chainB, PCIINFO_TREE_DEPTH);
+    if ( (intLenA < 0) || (intLenB < 0) ) {
+        return -1;
+    }
+    /* common part of chain */
+    for ( intCommon = 0; (intCommon < intLenA) && (intCommon < intLenB); intCommon++ ) {
+        if ( 0 != strcmp(chainA[intCommon], chainB[intCommon]) ) {
+            break;
+        }
+    }
+    /* common ancestor, empty if root complexes differ */
+    if ( (NULL != ancestor) && (0 < ancestorMax) ) {
+        ancestor[0] = '\0';
+        if ( 0 < intCommon ) {
+            strncpy(ancestor, chainA[intCommon - 1], ancestorMax - 1);
+            ancestor[ancestorMax - 1] = '\0';
+        }
+    }
+    pciinfo_printf("  INFO:%s: %s <-> %s, %d common nodes\n", __FUNCTION__, devA, devB, intCommon);
+    /* finish function */
+    return (intLenA - intCommon) + (intLenB - intCommon);
+}
+
+
+
+/**
+ *  pciinfoMatch
+ *    list of PCI devices passing the filter
+ */
+int pciinfoMatch(const t_pciinfo_match *match, t_pciinfo_dev dev[], uint32_t devMax)
+{
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* collect devices */
+    return pciinfo_enum(match, dev, devMax);
+}
+
+
+
+/**
+ *  pciinfoDriver
+ *    driver bound to PCI function
+ */
+int pciinfoDriver(const char sysPathPciDev[], char driver[], uint32_t driverMax)
+{
+    /** used variables **/
+    char    charPath[PCIINFO_PATH_MAX + 64];
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* check for device */
+    driver[0] = '\0';
+    if ( (size_t) snprintf(charPath, sizeof(charPath), "%s/vendor", sysPathPciDev) >= sizeof(charPath) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    if ( 0 != access(charPath, F_OK) ) {
+        pciinfo_printf("  ERROR:%s: '%s' is no PCI device\n", __FUNCTION__, sysPathPciDev);
+        return -1;
+    }
+    /* unbound function has no driver link */
+    if ( 0 != pciinfo_link_name(sysPathPciDev, "driver", driver, driverMax) ) {
+        driver[0] = '\0';
+    }
+    return 0;
+}
+
+
+
+/**
+ *  pciinfoIommuGroup
+ *    IOMMU group of PCI function
+ */
+int pciinfoIommuGroup(const char sysPathPciDev[])
+{
+    /** used variables **/
+    char    charGroup[32];
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* iommu_group -> ../../../kernel/iommu_groups/17 */
+    if ( 0 != pciinfo_link_name(sysPathPciDev, "iommu_group", charGroup, sizeof(charGroup)) ) {
+        return -1;
+    }
+    return (int) strtol(charGroup, NULL, 10);
+}
+
+
+
+/**
+ *  pciinfoBind
+ *    unbind, driver override and bind for all matching PCI functions
+ */
+int pciinfoBind(const t_pciinfo_match *match, const char driver[],
+                t_pciinfo_bind bind[], uint32_t bindMax)
+{
+    /** used variables **/
+    char            charPath[PATH_MAX];
+    int             intNum;
+    int             intErr;
+    uint64_t        uint64Start;
+    t_pciinfo_dev   *dev;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* acquire matching functions */
+    dev = calloc(bindMax, sizeof(t_pciinfo_dev));
+    if ( NULL == dev ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    intNum = pciinfo_enum(match, dev, bindMax);
+    if ( 0 > intNum ) {
+        free(dev);
+        return -1;
+    }
+    if ( (NULL != driver) && (strlen(driver) >= sizeof(bind[0].drvNew)) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        free(dev);
+        return -1;
+    }
+
+    /* process functions */
+    for ( int i = 0; i < intNum; i++ ) {
+        /* current state */
+        memset(&bind[i], 0, sizeof(bind[i]));
+        strcpy(bind[i].bdf, dev[i].bdf);
+        pciinfoDriver(dev[i].path, bind[i].drvOld, sizeof(bind[i].drvOld));
+        bind[i].iommuGroup = (int32_t) pciinfoIommuGroup(dev[i].path);
+        strcpy(bind[i].drvNew, bind[i].drvOld);
+        /* report only or already bound */
+        if ( (NULL == driver) || ('\0' == driver[0]) || (0 == strcmp(driver, bind[i].drvOld)) ) {
+            continue;
+        }
+        /* release from current driver */
+        if ( '\0' != bind[i].drvOld[0] ) {
+            snprintf(charPath, sizeof(charPath), "%s/driver/unbind", dev[i].path);
+            uint64Start = pciinfo_ns();
+            intErr = pciinfo_sysfs_write(charPath, dev[i].bdf);
+            bind[i].nsUnbind = pciinfo_ns() - uint64Start;
+            if ( 0 != intErr ) {
+                bind[i].errStep = "unbind";
+                bind[i].err = -intErr;
+                continue;
+            }
+            bind[i].drvNew[0] = '\0';
+        }
+        /* only new driver is allowed to probe the function */
+        snprintf(charPath, sizeof(charPath), "%s/driver_override", dev[i].path);
+        uint64Start = pciinfo_ns();
+        intErr = pciinfo_sysfs_write(charPath, driver);
+        bind[i].nsOverride = pciinfo_ns() - uint64Start;
+        if ( 0 != intErr ) {
+            bind[i].errStep = "override";
+            bind[i].err = -intErr;
+            continue;
+        }
+        /* bind to new driver */
+        snprintf(charPath, sizeof(charPath), "%s/bus/pci/drivers/%s/bind", g_pciinfoSysRoot, driver);
+        uint64Start = pciinfo_ns();
+        intErr = pciinfo_sysfs_write(charPath, dev[i].bdf);
+        bind[i].nsBind = pciinfo_ns() - uint64Start;
+        if ( 0 != intErr ) {
+            bind[i].errStep = "bind";
+            bind[i].err = -intErr;
+            continue;
+        }
+        /* driver after binding */
+        pciinfoDriver(dev[i].path, bind[i].drvNew, sizeof(bind[i].drvNew));
+        pciinfo_printf("  INFO:%s: %s '%s' -> '%s'\n", __FUNCTION__, bind[i].bdf, bind[i].drvOld, bind[i].drvNew);
+    }
+
+    /* finish function */
+    free(dev);
+    return intNum;
+}
+
+
+
+/**
+ *  pciinfoNamesCompile
+ *    converts text pci.ids into hashed binary database
+ */
+int pciinfoNamesCompile(const char idsFile[], const char dbFile[])
+{
+    /** used variables **/
+    char                    line[1024];         // read buffer
+    char                    *name;              // name in line
+    uint16_t                uint16Vendor = 0;   // current vendor
+    uint16_t                uint16Device = 0;   // current device
+    unsigned int            id[2];              // parsed ids
+    uint8_t                 uint8Class = 0;     // in device class section
+    t_pciinfo_names_hdr     hdr;                // database header
+    t_pciinfo_names_ent     *ent = NULL;        // parsed entries
+    t_pciinfo_names_ent     *tbl = NULL;        // hash table
+    char                    *str = NULL;        // string blob
+    void                    *ptr;               // reallocated memory
+    uint32_t                uint32EntNum = 0;   // parsed entries
+    uint32_t                uint32EntMax = 0;   // allocated entries
+    uint32_t                uint32StrMax = 0;   // allocated string blob
+    uint32_t                slot;
+    char                    charTmp[PATH_MAX];  // database written aside, renamed when complete
+    int                     fd;
+    int                     intRet = -1;
+    FILE                    *fIds;
+    FILE                    *fDb;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* defaults */
+    idsFile = (NULL == idsFile) ? PCIINFO_NAMES_IDS : idsFile;
+    dbFile = (NULL == dbFile) ? PCIINFO_NAMES_DB : dbFile;
+    memset(&hdr, 0, sizeof(hdr));
+
+    /* parse text database */
+    fIds = fopen(idsFile, "r");
+    if ( NULL == fIds ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, idsFile);
+        return -1;
+    }
+    while ( NULL != fgets(line, sizeof(line), fIds) ) {
+        line[strcspn(line, "\r\n")] = '\0';
+        /* skip comments and empty lines */
+        if ( ('#' == line[0]) || ('\0' == line[0]) ) {
+            continue;
+        }
+        /* device classes are not supported */
+        if ( 0 == strncmp(line, "C ", 2) ) {
+            uint8Class = 1;
+            continue;
+        }
+        if ( '\t' != line[0] ) {
+            uint8Class = 0;
+        }
+        if ( 0 != uint8Class ) {
+            continue;
+        }
+        /* grow entry list */
+        if ( uint32EntNum >= uint32EntMax ) {
+            uint32EntMax = (0 == uint32EntMax) ? 4096 : 2 * uint32EntMax;
+            ptr = realloc(ent, uint32EntMax * sizeof(*ent));
+            if ( NULL == ptr ) {
+                goto PCIINFO_NAMES_COMPILE_END;
+            }
+            ent = ptr;
+        }
+        memset(&ent[uint32EntNum], 0, sizeof(ent[0]));
+        /* subsystem: '\t\tsubvendor subdevice  name' */
+        if ( '\t' == line[1] ) {
+            if ( 2 != sscanf(line + 2, "%x %x", &id[0], &id[1]) ) {
+                continue;
+            }
+            ent[uint32EntNum].kind = PCIINFO_NAMES_SUBSYS;
+            ent[uint32EntNum].vendor = uint16Vendor;
+            ent[uint32EntNum].device = uint16Device;
+            ent[uint32EntNum].subVendor = (uint16_t) id[0];
+            ent[uint32EntNum].subDevice = (uint16_t) id[1];
+            name = line + 2 + 11;
+        /* device: '\tdevice  name' */
+        } else if ( '\t' == line[0] ) {
+            if ( 1 != sscanf(line + 1, "%x", &id[0]) ) {
+                continue;
+            }
+            uint16Device = (uint16_t) id[0];
+            ent[uint32EntNum].kind = PCIINFO_NAMES_DEVICE;
+            ent[uint32EntNum].vendor = uint16Vendor;
+            ent[uint32EntNum].device = uint16Device;
+            name = line + 1 + 6;
+        /* vendor: 'vendor  name' */
+        } else {
+            if ( 1 != sscanf(line, "%x", &id[0]) ) {
+                continue;
+            }
+            uint16Vendor = (uint16_t) id[0];
+            ent[uint32EntNum].kind = PCIINFO_NAMES_VENDOR;
+            ent[uint32EntNum].vendor = uint16Vendor;
+            name = line + 6;
+        }
+        /* name follows ids separated by two spaces */
+        if ( strlen(line) < (size_t) (name - line) ) {
+            continue;
+        }
+        /* append name to string blob */
+        while ( (hdr.strSize + strlen(name) + 1) > uint32StrMax ) {
+            uint32StrMax = (0 == uint32StrMax) ? 65536 : 2 * uint32StrMax;
+            ptr = realloc(str, uint32StrMax);
+            if ( NULL == ptr ) {
+                goto PCIINFO_NAMES_COMPILE_END;
+            }
+            str = ptr;
+        }
+        ent[uint32EntNum].str = hdr.strSize;
+        strcpy(str + hdr.strSize, name);
+        hdr.strSize += (uint32_t) strlen(name) + 1;
+        ++uint32EntNum;
+    }
+
+    /* no names, f.e. comment only file */
+    if ( 0 == uint32EntNum ) {
+        pciinfo_printf("  ERROR:%s: no names in '%s'\n", __FUNCTION__, idsFile);
+        goto PCIINFO_NAMES_COMPILE_END;
+    }
+
+    /* hash table with load factor below 0.5 */
+    hdr.slots = 1;
+    while ( hdr.slots < 2 * uint32EntNum ) {
+        hdr.slots <<= 1;
+    }
+    tbl = calloc(hdr.slots, sizeof(*tbl));
+    if ( NULL == tbl ) {
+        goto PCIINFO_NAMES_COMPILE_END;
+    }
+    for ( uint32_t i = 0; i < uint32EntNum; i++ ) {
+        slot = pciinfo_names_slot(ent[i].kind, ent[i].vendor, ent[i].device, ent[i].subVendor, ent[i].subDevice, hdr.slots);
+        while ( 0 != tbl[slot].kind ) {
+            /* first name wins for duplicate keys */
+            if ( (ent[i].kind == tbl[slot].kind) && (ent[i].vendor == tbl[slot].vendor) && (ent[i].device == tbl[slot].device) &&
+                 (ent[i].subVendor == tbl[slot].subVendor) && (ent[i].subDevice == tbl[slot].subDevice) ) {
+                break;
+            }
+            slot = (slot + 1) & (hdr.slots - 1);
+        }
+        if ( 0 == tbl[slot].kind ) {
+            tbl[slot] = ent[i];
+            ++hdr.entries;
+        }
+    }
+
+    /* write database aside, readers of the old one keep a complete file */
+    memcpy(hdr.magic, PCIINFO_NAMES_MAGIC, sizeof(hdr.magic));
+    if ( (size_t) snprintf(charTmp, sizeof(charTmp), "%s.XXXXXX", dbFile) >= sizeof(charTmp) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        goto PCIINFO_NAMES_COMPILE_END;
+    }
+    fd = mkstemp(charTmp);
+    if ( 0 > fd ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, charTmp);
+        goto PCIINFO_NAMES_COMPILE_END;
+    }
+    fDb = fdopen(fd, "wb");
+    if ( NULL == fDb ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, charTmp);
+        close(fd);
+        unlink(charTmp);
+        goto PCIINFO_NAMES_COMPILE_END;
+    }
+    if ( (1 == fwrite(&hdr, sizeof(hdr), 1, fDb)) &&
+         (hdr.slots == fwrite(tbl, sizeof(*tbl), hdr.slots, fDb)) &&
+         (hdr.strSize == fwrite(str, 1, hdr.strSize, fDb)) &&
+         (0 == fflush(fDb)) && (0 == fchmod(fd, 0644)) && (0 == fsync(fd)) ) {
+        intRet = (int) hdr.entries;
+    }
+    if ( 0 != fclose(fDb) ) {
+        intRet = -1;
+    }
+    /* replace database */
+    if ( (0 <= intRet) && (0 != rename(charTmp, dbFile)) ) {
+        pciinfo_printf("  ERROR:%s: failed to rename '%s' to '%s'.\n", __FUNCTION__, charTmp, dbFile);
+        intRet = -1;
+    }
+    if ( 0 > intRet ) {
+        unlink(charTmp);
+    }
+    pciinfo_printf("  INFO:%s: %u entries, %u slots, %u byte strings\n", __FUNCTION__, hdr.entries, hdr.slots, hdr.strSize);
+
+    /* release memory */
+    PCIINFO_NAMES_COMPILE_END:
+    if ( 0 > intRet ) {
+        pciinfo_printf("  ERROR:%s: failed to compile '%s'\n", __FUNCTION__, idsFile);
+    }
+    fclose(fIds);
+    free(ent);
+    free(tbl);
+    free(str);
+    return intRet;
+}
+
+
+
+/**
+ *  pciinfoNamesOpen
+ *    memory maps compiled PCI id database
+ */
+int pciinfoNamesOpen(const char dbFile[])
+{
+    /** used variables **/
+    int                         fd;
+    struct stat                 st;
+    void                        *map;
+    const t_pciinfo_names_hdr   *hdr;
+    const char                  *str;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* release previous */
+    pciinfoNamesClose();
+    dbFile = (NULL == dbFile) ? PCIINFO_NAMES_DB : dbFile;
+
+    /* map file */
+    fd = open(dbFile, O_RDONLY);
+    if ( 0 > fd ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, dbFile);
+        return -1;
+    }
+    if ( (0 != fstat(fd, &st)) || ((size_t) st.st_size < sizeof(t_pciinfo_names_hdr)) ) {
+        pciinfo_printf("  ERROR:%s: '%s' is no database\n", __FUNCTION__, dbFile);
+        close(fd);
+        return -1;
+    }
+    map = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if ( MAP_FAILED == map ) {
+        pciinfo_printf("  ERROR:%s: failed to map '%s'.\n", __FUNCTION__, dbFile);
+        return -1;
+    }
+    /* check format */
+    hdr = (const t_pciinfo_names_hdr*) map;
+    if ( (0 != memcmp(hdr->magic, PCIINFO_NAMES_MAGIC, sizeof(hdr->magic))) ||
+         (0 == hdr->slots) || (0 != (hdr->slots & (hdr->slots - 1))) ||
+         ((size_t) st.st_size != sizeof(*hdr) + (size_t) hdr->slots * sizeof(t_pciinfo_names_ent) + hdr->strSize) ) {
+        pciinfo_printf("  ERROR:%s: '%s' has unsupported format\n", __FUNCTION__, dbFile);
+        munmap(map, (size_t) st.st_size);
+        return -1;
+    }
+    /* terminated blob, name offsets are checked on lookup */
+    str = (const char*) map + sizeof(*hdr) + (size_t) hdr->slots * sizeof(t_pciinfo_names_ent);
+    if ( (0 == hdr->strSize) || ('\0' != str[hdr->strSize - 1]) ) {
+        pciinfo_printf("  ERROR:%s: '%s' has unterminated names\n", __FUNCTION__, dbFile);
+        munmap(map, (size_t) st.st_size);
+        return -1;
+    }
+    g_pciinfoNames = (const uint8_t*) map;
+    g_pciinfoNamesSize = (size_t) st.st_size;
+    return 0;
+}
+
+
+
+/**
+ *  pciinfoNamesClose
+ *    unmaps PCI id database
+ */
+void pciinfoNamesClose(void)
+{
+    if ( NULL != g_pciinfoNames ) {
+        munmap((void*) g_pciinfoNames, g_pciinfoNamesSize);
+    }
+    g_pciinfoNames = NULL;
+    g_pciinfoNamesSize = 0;
+}
+
+
+
+/**
+ *  pciinfoNameVendor
+ *    vendor name lookup
+ */
+const char* pciinfoNameVendor(uint16_t vendor)
+{
+    return pciinfo_names_get(PCIINFO_NAMES_VENDOR, vendor, 0, 0, 0);
+}
+
+
+
+/**
+ *  pciinfoNameDevice
+ *    device name lookup
+ */
+const char* pciinfoNameDevice(uint16_t vendor, uint16_t device)
+{
+    return pciinfo_names_get(PCIINFO_NAMES_DEVICE, vendor, device, 0, 0);
+}
+
+
+
+/**
+ *  pciinfoNameSubsys
+ *    subsystem name lookup
+ */
+const char* pciinfoNameSubsys(uint16_t vendor, uint16_t device, uint16_t subVendor,
+                              uint16_t subDevice)
+{
+    return pciinfo_names_get(PCIINFO_NAMES_SUBSYS, vendor, device, subVendor, subDevice);
+}
+
+
+
+/**
+ *  pciinfoBarMap
+ *    memory maps BAR file
+ */
+void* pciinfoBarMap(const char barFile[], int writeable, size_t *size)
+{
+    /** used variables **/
+    int         fd;
+    struct stat st;
+    void        *map;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* open BAR */
+    *size = 0;
+    fd = open(barFile, (0 != writeable) ? (O_RDWR | O_SYNC) : (O_RDONLY | O_SYNC));
+    if ( 0 > fd ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, barFile);
+        return NULL;
+    }
+    if ( (0 != fstat(fd, &st)) || (0 == st.st_size) ) {
+        pciinfo_printf("  ERROR:%s: '%s' has no size\n", __FUNCTION__, barFile);
+        close(fd);
+        return NULL;
+    }
+    /* map complete BAR */
+    map = mmap(NULL, (size_t) st.st_size, (0 != writeable) ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if ( MAP_FAILED == map ) {
+        pciinfo_printf("  ERROR:%s: failed to map '%s'.\n", __FUNCTION__, barFile);
+        return NULL;
+    }
+    *size = (size_t) st.st_size;
+    pciinfo_printf("  INFO:%s: '%s' with %zu byte\n", __FUNCTION__, barFile, *size);
+    return map;
+}
+
+
+
+/**
+ *  pciinfoBarUnmap
+ *    release BAR mapping
+ */
+void pciinfoBarUnmap(void *bar, size_t size)
+{
+    if ( NULL != bar ) {
+        munmap(bar, size);
+    }
+}
+
+
+
+/**
+ *  pciinfo_watch_writer
+ *    drains sample ring buffer into trace file
+ */
+static void* pciinfo_watch_writer(void *arg)
+{
+    t_pciinfo_ring  *ring = (t_pciinfo_ring*) arg;
+    uint64_t        head;
+    uint64_t        tail;
+    size_t          len;
+    struct timespec ts = {0, 1000000};  // 1ms
+
+    tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    for ( ;; ) {
+        head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        /* empty */
+        if ( head == tail ) {
+            if ( 0 != atomic_load_explicit(&ring->done, memory_order_acquire) ) {
+                /* producer could have written before done */
+                if ( head == atomic_load_explicit(&ring->head, memory_order_acquire) ) {
+                    break;
+                }
+                continue;
+            }
+            nanosleep(&ts, NULL);
+            continue;
+        }
+        /* continuous part up to end of ring */
+        len = (size_t) (head - tail);
+        if ( len > PCIINFO_WATCH_RING - (tail & (PCIINFO_WATCH_RING - 1)) ) {
+            len = PCIINFO_WATCH_RING - (tail & (PCIINFO_WATCH_RING - 1));
+        }
+        if ( len != fwrite(&ring->buf[tail & (PCIINFO_WATCH_RING - 1)], sizeof(ring->buf[0]), len, ring->trace) ) {
+            ring->err = -1;
+        }
+        tail += len;
+        atomic_store_explicit(&ring->tail, tail, memory_order_release);
+    }
+    return NULL;
+}
+
+
+
+/**
+ *  pciinfoWatch
+ *    samples BAR registers into trace file
+ */
+int pciinfoWatch(t_pciinfo_watch *watch)
+{
+    /** used variables **/
+    volatile uint32_t   *bar;               // mapped BAR
+    size_t              barSize;            // mapped size
+    uint32_t            *last = NULL;       // last register values
+    uint32_t            val;                // register value
+    uint64_t            head;               // ring write position
+    uint64_t            ns;                 // sample time
+    uint64_t            uint64Start;        // sampling start
+    uint64_t            uint64Period;       // sample period in ns
+    uint64_t            uint64Next;         // next sample deadline in ns
+    struct timespec     tsNext;             // next sample deadline
+    t_pciinfo_ring      *ring;              // sample buffer
+    pthread_t           writer;             // trace writer thread
+    int                 intRet = 0;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* init statistic */
+    watch->sampled = 0;
+    watch->logged = 0;
+    watch->dropped = 0;
+    watch->ns = 0;
+
+    /* rate needs at least one nanosecond period */
+    if ( watch->rateHz > 1000000000UL ) {
+        pciinfo_printf("  ERROR:%s: rate %u Hz exceeds 1 GHz\n", __FUNCTION__, watch->rateHz);
+        return -1;
+    }
+    uint64Period = (0 == watch->rateHz) ? 0 : (1000000000ULL / watch->rateHz);
+
+    /* map BAR and check offsets */
+    bar = pciinfoBarMap(watch->barFile, 0, &barSize);
+    if ( NULL == bar ) {
+        return -1;
+    }
+    for ( uint32_t i = 0; i < watch->offNum; i++ ) {
+        if ( (0 != (watch->off[i] & 0x3)) || ((size_t) watch->off[i] + sizeof(uint32_t) > barSize) ) {
+            pciinfo_printf("  ERROR:%s: offset 0x%x outside BAR or unaligned\n", __FUNCTION__, watch->off[i]);
+            pciinfoBarUnmap((void*) bar, barSize);
+            return -1;
+        }
+    }
+    /* buffers */
+    ring = calloc(1, sizeof(*ring));
+    last = calloc((0 == watch->offNum) ? 1 : watch->offNum, sizeof(*last));
+    if ( (NULL == ring) || (NULL == last) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        intRet = -1;
+        goto PCIINFO_WATCH_FREE;
+    }
+    /* trace file */
+    ring->trace = fopen(watch->traceFile, "wb");
+    if ( NULL == ring->trace ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, watch->traceFile);
+        intRet = -1;
+        goto PCIINFO_WATCH_FREE;
+    }
+    if ( 1 != fwrite(PCIINFO_WATCH_MAGIC, sizeof(PCIINFO_WATCH_MAGIC) - 1, 1, ring->trace) ) {
+        intRet = -1;
+        goto PCIINFO_WATCH_CLOSE;
+    }
+    /* start trace writer */
+    if ( 0 != pthread_create(&writer, NULL, pciinfo_watch_writer, ring) ) {
+        pciinfo_printf("  ERROR:%s: failed to start trace writer\n", __FUNCTION__);
+        intRet = -1;
+        goto PCIINFO_WATCH_CLOSE;
+    }
+
+    /* sample */
+    head = 0;
+    uint64Start = pciinfo_ns();
+    uint64Next = uint64Start;
+    while ( ((0 == watch->count) || (watch->sampled < watch->count)) &&
+            ((NULL == watch->stop) || (0 == *watch->stop)) ) {
+        for ( uint32_t i = 0; i < watch->offNum; i++ ) {
+            val = bar[watch->off[i] / sizeof(uint32_t)];
+            ns = pciinfo_ns();
+            /* changes only, first sample is always logged */
+            if ( (0 != watch->onlyChange) && (0 != watch->sampled) && (last[i] == val) ) {
+                continue;
+            }
+            last[i] = val;
+            /* ring full, writer is behind */
+            if ( (head - atomic_load_explicit(&ring->tail, memory_order_acquire)) >= PCIINFO_WATCH_RING ) {
+                ++watch->dropped;
+                continue;
+            }
+            ring->buf[head & (PCIINFO_WATCH_RING - 1)].ns = ns;
+            ring->buf[head & (PCIINFO_WATCH_RING - 1)].off = watch->off[i];
+            ring->buf[head & (PCIINFO_WATCH_RING - 1)].val = val;
+            atomic_store_explicit(&ring->head, ++head, memory_order_release);
+        }
+        ++watch->sampled;
+        /* wait for next period, busy poll otherwise */
+        if ( 0 != uint64Period ) {
+            uint64Next += uint64Period;
+            /* overrun, skip missed periods instead of sampling back to back */
+            ns = pciinfo_ns();
+            if ( uint64Next <= ns ) {
+                uint64Next += ((ns - uint64Next) / uint64Period + 1) * uint64Period;
+            }
+            tsNext.tv_sec = (time_t) (uint64Next / 1000000000ULL);
+            tsNext.tv_nsec = (long) (uint64Next % 1000000000ULL);
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tsNext, NULL);
+        }
+    }
+    watch->ns = pciinfo_ns() - uint64Start;
+    watch->logged = head;
+
+    /* drain ring buffer */
+    atomic_store_explicit(&ring->done, 1, memory_order_release);
+    pthread_join(writer, NULL);
+    if ( 0 != ring->err ) {
+        pciinfo_printf("  ERROR:%s: failed to write '%s'.\n", __FUNCTION__, watch->traceFile);
+        intRet = -1;
+    }
+    pciinfo_printf  (   "  INFO:%s: %lu sampled, %lu logged, %lu dropped\n", __FUNCTION__,
+                        (unsigned long) watch->sampled, (unsigned long) watch->logged, (unsigned long) watch->dropped
+                    );
+
+    /* release resources */
+    PCIINFO_WATCH_CLOSE:
+    if ( 0 != fclose(ring->trace) ) {
+        intRet = -1;
+    }
+    PCIINFO_WATCH_FREE:
+    free(ring);
+    free(last);
+    pciinfoBarUnmap((void*) bar, barSize);
+    return intRet;
+}
+
+
+
+/**
+ *  pciinfo_bar_open
+ *    maps BAR and bounds range by BAR size
+ */
+static volatile uint64_t* pciinfo_bar_open(const char sysPathPciDev[], uint8_t bar, int writeable,
+                                           uint64_t off, uint64_t *len, size_t *mapSize)
+{
+    char                charBarFile[PCIINFO_PATH_MAX + 16];
+    uint32_t            uint32BarSize;
+    volatile uint64_t   *map;
+
+    /* bound range */
+    if ( (0 != pciinfoBarSize(sysPathPciDev, bar, &uint32BarSize)) || (0 == uint32BarSize) ) {
+        pciinfo_printf("  ERROR:%s: BAR%d of '%s' not present\n", __FUNCTION__, bar, sysPathPciDev);
+        return NULL;
+    }
+    if ( 0 == *len ) {
+        *len = (off < uint32BarSize) ? (uint32BarSize - off) : 0;
+    }
+    if ( (0 != (off & 0x7)) || (0 != (*len & 0x7)) || (0 == *len) || ((off + *len) > uint32BarSize) ) {
+        pciinfo_printf  (   "  ERROR:%s: range 0x%lx+0x%lx outside of BAR%d size 0x%x or unaligned\n", __FUNCTION__,
+                            (unsigned long) off, (unsigned long) *len, bar, uint32BarSize
+                        );
+        return NULL;
+    }
+    /* map BAR */
+    if ( (size_t) snprintf(charBarFile, sizeof(charBarFile), "%s/resource%d", sysPathPciDev, bar) >= sizeof(charBarFile) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return NULL;
+    }
+    map = pciinfoBarMap(charBarFile, writeable, mapSize);
+    if ( (NULL != map) && ((off + *len) > *mapSize) ) {
+        pciinfoBarUnmap((void*) map, *mapSize);
+        return NULL;
+    }
+    return map;
+}
+
+
+
+/**
+ *  pciinfo_bar_read / pciinfo_bar_write
+ *    64bit aligned block copy, volatile side is the BAR
+ */
+static void pciinfo_bar_read(uint64_t *dst, const volatile uint64_t *src, size_t len)
+{
+    for ( size_t i = 0; i < len / sizeof(uint64_t); i++ ) {
+        dst[i] = src[i];
+    }
+}
+
+static void pciinfo_bar_write(volatile uint64_t *dst, const uint64_t *src, size_t len)
+{
+    for ( size_t i = 0; i < len / sizeof(uint64_t); i++ ) {
+        dst[i] = src[i];
+    }
+}
+
+
+
+/**
+ *  pciinfoBarDump
+ *    BAR range into file
+ */
+int pciinfoBarDump(const char sysPathPciDev[], uint8_t bar, uint64_t off, uint64_t len,
+                   const char file[], t_pciinfo_xfer *xfer)
+{
+    /** used variables **/
+    volatile uint64_t   *map;           // mapped BAR
+    size_t              mapSize;        // size of mapping
+    uint64_t            *buf;           // block buffer
+    size_t              blk;            // current block size
+    uint64_t            uint64Start;    // transfer start
+    uint8_t             uint8Created = 0;   // image is a regular file
+    struct stat         st;
+    int                 intRet = 0;
+    FILE                *fptr;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* map */
+    map = pciinfo_bar_open(sysPathPciDev, bar, 0, off, &len, &mapSize);
+    if ( NULL == map ) {
+        return -1;
+    }
+    fptr = NULL;
+    buf = aligned_alloc(PCIINFO_XFER_LINE, PCIINFO_XFER_BLOCK);
+    if ( NULL == buf ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        intRet = -1;
+        goto PCIINFO_BAR_DUMP_END;
+    }
+    fptr = fopen(file, "wb");
+    if ( NULL == fptr ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, file);
+        intRet = -1;
+        goto PCIINFO_BAR_DUMP_END;
+    }
+    uint8Created = (uint8_t) ((0 == fstat(fileno(fptr), &st)) && S_ISREG(st.st_mode));
+    /* copy blocks */
+    uint64Start = pciinfo_ns();
+    for ( uint64_t pos = 0; pos < len; pos += blk ) {
+        blk = (len - pos > PCIINFO_XFER_BLOCK) ? PCIINFO_XFER_BLOCK : (size_t) (len - pos);
+        pciinfo_bar_read(buf, map + (off + pos) / sizeof(uint64_t), blk);
+        if ( blk != fwrite(buf, 1, blk, fptr) ) {
+            pciinfo_printf("  ERROR:%s: failed to write '%s'.\n", __FUNCTION__, file);
+            intRet = -1;
+            break;
+        }
+    }
+    if ( NULL != xfer ) {
+        xfer->ns = pciinfo_ns() - uint64Start;
+        xfer->bytes = len;
+        xfer->lines = 0;
+    }
+
+    /* release resources */
+    PCIINFO_BAR_DUMP_END:
+    if ( (NULL != fptr) && (0 != fclose(fptr)) ) {
+        intRet = -1;
+    }
+    /* no partial image, only regular files are removed */
+    if ( (0 != intRet) && (0 != uint8Created) ) {
+        unlink(file);
+    }
+    free(buf);
+    pciinfoBarUnmap((void*) map, mapSize);
+    return intRet;
+}
+
+
+
+/**
+ *  pciinfoBarRestore
+ *    file into BAR
+ */
+int pciinfoBarRestore(const char sysPathPciDev[], uint8_t bar, uint64_t off,
+                      const char file[], t_pciinfo_xfer *xfer)
 {
     /** used variables **/
-    char     cmd[256];                 /* command buffer */
-    char     devPath[256];             /* path buffer */
-    char     line1[1024], line2[1024]; /* read buffer */
-    uint16_t uint16DevPathIdx;         /* match with buff */
-    uint8_t  uint8FoundDevice;         /* device found */
-    FILE     *foundVendor;             /* system call answer */
-    FILE     *foundDevice;
+    volatile uint64_t   *map = NULL;    // mapped BAR
+    size_t              mapSize = 0;    // size of mapping
+    uint64_t            *buf;           // block buffer
+    uint64_t            len;            // image size
+    size_t              blk;            // current block size
+    uint64_t            uint64Start;    // transfer start
+    struct stat         st;
+    int                 intRet = 0;
+    FILE                *fptr;
 
     /* function call message */
     pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
 
-    /* search in system path for pci devices*/
-    strcpy(cmd, "grep -irnw /sys/bus/pci/devices/*/vendor -e ");
-    strcat(cmd, vendorID);
-    foundVendor = popen(cmd, "r");
+    /* image */
+    fptr = NULL;
+    buf = aligned_alloc(PCIINFO_XFER_LINE, PCIINFO_XFER_BLOCK);
+    if ( NULL == buf ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        intRet = -1;
+        goto PCIINFO_BAR_RESTORE_END;
+    }
+    fptr = fopen(file, "rb");
+    if ( (NULL == fptr) || (0 != fstat(fileno(fptr), &st)) ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, file);
+        intRet = -1;
+        goto PCIINFO_BAR_RESTORE_END;
+    }
+    len = (uint64_t) st.st_size;
+    /* map */
+    map = pciinfo_bar_open(sysPathPciDev, bar, 1, off, &len, &mapSize);
+    if ( NULL == map ) {
+        intRet = -1;
+        goto PCIINFO_BAR_RESTORE_END;
+    }
+    /* copy blocks */
+    uint64Start = pciinfo_ns();
+    for ( uint64_t pos = 0; pos < len; pos += blk ) {
+        blk = (len - pos > PCIINFO_XFER_BLOCK) ? PCIINFO_XFER_BLOCK : (size_t) (len - pos);
+        if ( blk != fread(buf, 1, blk, fptr) ) {
+            pciinfo_printf("  ERROR:%s: failed to read '%s'.\n", __FUNCTION__, file);
+            intRet = -1;
+            break;
+        }
+        pciinfo_bar_write(map + (off + pos) / sizeof(uint64_t), buf, blk);
+    }
+    if ( NULL != xfer ) {
+        xfer->ns = pciinfo_ns() - uint64Start;
+        xfer->bytes = len;
+        xfer->lines = 0;
+    }
 
-    /* process found device list for device ID */
-    uint8FoundDevice = 0;
-    while (EOF != fscanf(foundVendor, "%s", line1)) {
-        /*  extract device path for given vendor id
-         *  before: /sys/bus/pci/devices/0000:03:0d.0/vendor:1:0x110a
-         *  after:  /sys/bus/pci/devices/0000:03:0d.0
-         */
-        if ( (strstr(line1, "/vendor") - line1) <
-            ((int)(sizeof(devPath) / sizeof(devPath[0]))) ) {
-            uint16DevPathIdx = (uint16_t)(strstr(line1, "/vendor") - line1);
+    /* release resources */
+    PCIINFO_BAR_RESTORE_END:
+    if ( NULL != fptr ) {
+        fclose(fptr);
+    }
+    free(buf);
+    pciinfoBarUnmap((void*) map, mapSize);
+    return intRet;
+}
+
+
+
+/**
+ *  pciinfoBarDiff
+ *    changed lines between two BAR images or image and live BAR
+ */
+int pciinfoBarDiff(const char sysPathPciDev[], uint8_t bar, uint64_t off, const char fileA[],
+                   const char fileB[], FILE *report, t_pciinfo_xfer *xfer)
+{
+    /** used variables **/
+    volatile uint64_t   *map = NULL;    // mapped BAR
+    size_t              mapSize = 0;    // size of mapping
+    uint64_t            *bufA;          // block buffer
+    uint64_t            *bufB;          // block buffer
+    uint64_t            len;            // image size
+    size_t              blk;            // current block size
+    uint64_t            uint64Start;    // transfer start
+    uint64_t            uint64Lines = 0;    // changed lines
+    struct stat         st;
+    int                 intRet = 0;
+    FILE                *fA = NULL;
+    FILE                *fB = NULL;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* images */
+    bufA = aligned_alloc(PCIINFO_XFER_LINE, PCIINFO_XFER_BLOCK);
+    bufB = aligned_alloc(PCIINFO_XFER_LINE, PCIINFO_XFER_BLOCK);
+    fA = fopen(fileA, "rb");
+    if ( (NULL == bufA) || (NULL == bufB) || (NULL == fA) || (0 != fstat(fileno(fA), &st)) ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, fileA);
+        intRet = -1;
+        goto PCIINFO_BAR_DIFF_END;
+    }
+    len = (uint64_t) st.st_size;
+    if ( NULL != fileB ) {
+        fB = fopen(fileB, "rb");
+        if ( (NULL == fB) || (0 != fstat(fileno(fB), &st)) || (len != (uint64_t) st.st_size) ) {
+            pciinfo_printf("  ERROR:%s: '%s' not present or size differs\n", __FUNCTION__, fileB);
+            intRet = -1;
+            goto PCIINFO_BAR_DIFF_END;
+        }
+    } else {
+        map = pciinfo_bar_open(sysPathPciDev, bar, 0, off, &len, &mapSize);
+        if ( NULL == map ) {
+            intRet = -1;
+            goto PCIINFO_BAR_DIFF_END;
+        }
+    }
+    /* compare blocks */
+    uint64Start = pciinfo_ns();
+    for ( uint64_t pos = 0; pos < len; pos += blk ) {
+        blk = (len - pos > PCIINFO_XFER_BLOCK) ? PCIINFO_XFER_BLOCK : (size_t) (len - pos);
+        if ( blk != fread(bufA, 1, blk, fA) ) {
+            intRet = -1;
+            break;
+        }
+        if ( NULL != fB ) {
+            if ( blk != fread(bufB, 1, blk, fB) ) {
+                intRet = -1;
+                break;
+            }
         } else {
-            uint16DevPathIdx = 0;
-            pciinfo_printf("Not enough memory to store PCI device path...\n");
+            pciinfo_bar_read(bufB, map + (off + pos) / sizeof(uint64_t), blk);
         }
-        strncpy(devPath, line1, uint16DevPathIdx);
-        devPath[uint16DevPathIdx] = '\0';    /* termination character */
+        /* changed lines, last line could be partial */
+        for ( size_t line = 0; line < blk; line += PCIINFO_XFER_LINE ) {
+            size_t  lineLen = (blk - line > PCIINFO_XFER_LINE) ? PCIINFO_XFER_LINE : (blk - line);
+            if ( 0 == memcmp((uint8_t*) bufA + line, (uint8_t*) bufB + line, lineLen) ) {
+                continue;
+            }
+            ++uint64Lines;
+            if ( NULL != report ) {
+                for ( uint8_t k = 0; k < 2; k++ ) {
+                    const uint32_t *word = (const uint32_t*) ((uint8_t*) ((0 == k) ? bufA : bufB) + line);
+                    fprintf(report, "0x%08lx %c", (unsigned long) (off + pos + line), (0 == k) ? '<' : '>');
+                    for ( size_t w = 0; w < lineLen / sizeof(uint32_t); w++ ) {
+                        fprintf(report, " %08x", word[w]);
+                    }
+                    fprintf(report, "\n");
+                }
+            }
+        }
+    }
+    if ( NULL != xfer ) {
+        xfer->ns = pciinfo_ns() - uint64Start;
+        xfer->bytes = len;
+        xfer->lines = uint64Lines;
+    }
+    if ( 0 == intRet ) {
+        intRet = (int) uint64Lines;
+    }
 
-        /*  build command for device id look up
-         *  cat /sys/bus/pci/devices/0000:03:0d.0/device
-         */
-        strcpy(cmd, "cat ");
-        strcat(cmd, devPath);
-        strcat(cmd, "/device");
-        foundDevice = popen(cmd, "r");
+    /* release resources */
+    PCIINFO_BAR_DIFF_END:
+    if ( NULL != fA ) {
+        fclose(fA);
+    }
+    if ( NULL != fB ) {
+        fclose(fB);
+    }
+    free(bufA);
+    free(bufB);
+    pciinfoBarUnmap((void*) map, mapSize);
+    return intRet;
+}
+
+
+
+/**
+ *  pciinfo_irq_cmp
+ *    qsort compare, sort by IRQ number
+ */
+static int pciinfo_irq_cmp(const void *a, const void *b)
+{
+    uint32_t    irqA = ((const t_pciinfo_irq*) a)->irq;
+    uint32_t    irqB = ((const t_pciinfo_irq*) b)->irq;
+
+    return (irqA > irqB) - (irqA < irqB);
+}
+
+
+
+/**
+ *  pciinfo_irq_reset
+ *    clears vector, releases per CPU counts of a previous call
+ */
+static void pciinfo_irq_reset(t_pciinfo_irq *irq)
+{
+    free(irq->cpuCount);
+    memset(irq, 0, sizeof(*irq));
+}
+
+
+
+/**
+ *  pciinfo_cpulist
+ *    expands CPU list '0-3,8' into CPU numbers
+ */
+static int pciinfo_cpulist(const char str[], uint16_t cpu[], uint32_t cpuMax)
+{
+    const char      *pos = str;
+    char            *end;
+    unsigned long   first;
+    unsigned long   last;
+    uint32_t        num = 0;
+
+    while ( '\0' != *pos ) {
+        first = strtoul(pos, &end, 10);
+        if ( end == pos ) {
+            break;
+        }
+        last = first;
+        if ( '-' == *end ) {
+            pos = end + 1;
+            last = strtoul(pos, &end, 10);
+        }
+        for ( unsigned long i = first; (i <= last) && (num < cpuMax); i++ ) {
+            cpu[num++] = (uint16_t) i;
+        }
+        pos = (',' == *end) ? end + 1 : end;
+    }
+    return (int) num;
+}
+
+
+
+/**
+ *  pciinfoIrqList
+ *    interrupt vectors of PCI device with counts and affinity
+ */
+int pciinfoIrqList(const char sysPathPciDev[], t_pciinfo_irq irq[], uint32_t irqMax)
+{
+    /** used variables **/
+    char            charPath[PATH_MAX];
+    char            charVal[16];
+    char            *line = NULL;       // /proc/interrupts line, one column per CPU, grows with CPUs
+    size_t          lineMax = 0;
+    char            *pos;
+    char            *end;
+    uint32_t        num = 0;
+    uint32_t        uint32CpuNum = 0;   // CPU columns in /proc/interrupts
+    uint64_t        uint64Cnt;          // interrupts of one CPU
+    unsigned long   irqNum;
+    DIR             *dir;
+    struct dirent   *ent;
+    FILE            *fptr;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* MSI/MSI-X vectors */
+    snprintf(charPath, sizeof(charPath), "%s/msi_irqs", sysPathPciDev);
+    dir = opendir(charPath);
+    if ( NULL != dir ) {
+        while ( NULL != (ent = readdir(dir)) ) {
+            irqNum = strtoul(ent->d_name, &end, 10);
+            if ( (end == ent->d_name) || ('\0' != *end) ) {
+                continue;
+            }
+            if ( NULL == irq ) {
+                ++num;  // count only
+                continue;
+            }
+            if ( num >= irqMax ) {
+                pciinfo_printf("  ERROR:%s: Not enough memory, more than %u vectors\n", __FUNCTION__, irqMax);
+                closedir(dir);
+                return -1;
+            }
+            pciinfo_irq_reset(&irq[num]);
+            irq[num++].irq = (uint32_t) irqNum;
+        }
+        closedir(dir);
+    }
+    /* legacy interrupt */
+    if ( (0 == num) && ((NULL == irq) || (0 < irqMax)) && (0 == pciinfo_sysfs_read(sysPathPciDev, "irq", charVal, sizeof(charVal))) ) {
+        irqNum = strtoul(charVal, NULL, 10);
+        if ( (0 != irqNum) && (NULL == irq) ) {
+            ++num;
+        } else if ( 0 != irqNum ) {
+            pciinfo_irq_reset(&irq[num]);
+            irq[num++].irq = (uint32_t) irqNum;
+        }
+    }
+    if ( NULL == irq ) {
+        return (int) num;
+    }
+    qsort(irq, num, sizeof(irq[0]), pciinfo_irq_cmp);
+
+    /* current affinity */
+    for ( uint32_t i = 0; i < num; i++ ) {
+        snprintf(charPath, sizeof(charPath), "%s/irq/%u", g_pciinfoProcRoot, irq[i].irq);
+        pciinfo_sysfs_read(charPath, "smp_affinity_list", irq[i].affinity, sizeof(irq[i].affinity));
+    }
+
+    /* interrupt counts */
+    snprintf(charPath, sizeof(charPath), "%s/interrupts", g_pciinfoProcRoot);
+    fptr = fopen(charPath, "r");
+    if ( NULL == fptr ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, charPath);
+        return -1;
+    }
+    /* header: '           CPU0       CPU1' */
+    if ( 0 <= getline(&line, &lineMax, fptr) ) {
+        for ( pos = strstr(line, "CPU"); NULL != pos; pos = strstr(pos + 3, "CPU") ) {
+            ++uint32CpuNum;
+        }
+    }
+    /* per CPU counts */
+    for ( uint32_t i = 0; i < num; i++ ) {
+        irq[i].cpuCount = calloc((0 == uint32CpuNum) ? 1 : uint32CpuNum, sizeof(irq[i].cpuCount[0]));
+        if ( NULL == irq[i].cpuCount ) {
+            pciinfo_printf("  ERROR:%s: Not enough memory for %u CPUs\n", __FUNCTION__, uint32CpuNum);
+            free(line);
+            fclose(fptr);
+            return -1;
+        }
+    }
+    /* ' 45:   c0   c1  IR-PCI-MSI ...' */
+    while ( 0 <= getline(&line, &lineMax, fptr) ) {
+        irqNum = strtoul(line, &end, 10);
+        if ( (end == line) || (':' != *end) ) {
+            continue;
+        }
+        for ( uint32_t i = 0; i < num; i++ ) {
+            if ( irq[i].irq != irqNum ) {
+                continue;
+            }
+            pos = end + 1;
+            for ( uint32_t cpu = 0; cpu < uint32CpuNum; cpu++ ) {
+                uint64Cnt = (uint64_t) strtoull(pos, &end, 10);
+                if ( end == pos ) {
+                    break;
+                }
+                irq[i].count += uint64Cnt;
+                irq[i].cpuCount[cpu] = uint64Cnt;
+                irq[i].cpuNum = cpu + 1;
+                pos = end;
+            }
+        }
+    }
+    free(line);
+    fclose(fptr);
+
+    /* finish function */
+    return (int) num;
+}
+
+
+
+/**
+ *  pciinfoIrqSpread
+ *    round robin assignment of vectors to device-local CPUs
+ */
+int pciinfoIrqSpread(const char sysPathPciDev[], t_pciinfo_irq irq[], uint32_t irqMax)
+{
+    /** used variables **/
+    char        charPath[PATH_MAX];
+    char        charList[PCIINFO_CPULIST_MAX];
+    char        charCpu[16];
+    uint16_t    cpu[PCIINFO_CPU_MAX];
+    int         intCpuNum;
+    int         intNum;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* device-local CPUs, all online CPUs as fallback */
+    intCpuNum = 0;
+    if ( 0 == pciinfo_sysfs_read(sysPathPciDev, "local_cpulist", charList, sizeof(charList)) ) {
+        intCpuNum = pciinfo_cpulist(charList, cpu, PCIINFO_CPU_MAX);
+    }
+    if ( 0 == intCpuNum ) {
+        snprintf(charPath, sizeof(charPath), "%s/devices/system/cpu", g_pciinfoSysRoot);
+        if ( 0 == pciinfo_sysfs_read(charPath, "online", charList, sizeof(charList)) ) {
+            intCpuNum = pciinfo_cpulist(charList, cpu, PCIINFO_CPU_MAX);
+        }
+    }
+    if ( 0 == intCpuNum ) {
+        pciinfo_printf("  ERROR:%s: no CPU for '%s'\n", __FUNCTION__, sysPathPciDev);
+        return -1;
+    }
+    /* vectors */
+    intNum = pciinfoIrqList(sysPathPciDev, irq, irqMax);
+    if ( 0 > intNum ) {
+        return -1;
+    }
+    /* apply plan */
+    for ( int i = 0; i < intNum; i++ ) {
+        snprintf(charPath, sizeof(charPath), "%s/irq/%u/smp_affinity_list", g_pciinfoProcRoot, irq[i].irq);
+        snprintf(charCpu, sizeof(charCpu), "%u", cpu[i % intCpuNum]);
+        if ( 0 != pciinfo_sysfs_store(charPath, charCpu, O_TRUNC) ) {
+            pciinfo_printf("  ERROR:%s: IRQ %u to CPU %s\n", __FUNCTION__, irq[i].irq, charCpu);
+            return -1;
+        }
+        pciinfo_printf("  INFO:%s: IRQ %u to CPU %s\n", __FUNCTION__, irq[i].irq, charCpu);
+    }
+    /* read back */
+    return pciinfoIrqList(sysPathPciDev, irq, irqMax);
+}
+
+
+
+/**
+ *  pciinfoIrqFree
+ *    releases per CPU counts
+ */
+void pciinfoIrqFree(t_pciinfo_irq irq[], uint32_t irqMax)
+{
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* release */
+    for ( uint32_t i = 0; i < irqMax; i++ ) {
+        pciinfo_irq_reset(&irq[i]);
+    }
+}
+
+
+
+/**
+ *  pciinfoAerRead
+ *    AER counters of PCI device
+ */
+int pciinfoAerRead(const char sysPathPciDev[], t_pciinfo_aer *aer)
+{
+    /** used variables **/
+    const char  *charFile[] = {"aer_dev_correctable", "aer_dev_nonfatal", "aer_dev_fatal"};
+    char        charPath[PATH_MAX];
+    char        charName[64];
+    uint64_t    uint64Val;
+    uint8_t     uint8Found = 0;
+    FILE        *fptr;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* 'RxErr 0' lines */
+    memset(aer, 0, sizeof(*aer));
+    for ( uint8_t i = 0; i < sizeof(charFile) / sizeof(charFile[0]); i++ ) {
+        snprintf(charPath, sizeof(charPath), "%s/%s", sysPathPciDev, charFile[i]);
+        fptr = fopen(charPath, "r");
+        if ( NULL == fptr ) {
+            continue;
+        }
+        ++uint8Found;
+        while ( 2 == fscanf(fptr, "%63s %" SCNu64, charName, &uint64Val) ) {
+            if ( 0 == strcmp(charName, "TOTAL_ERR_COR") ) {
+                aer->corTotal = uint64Val;
+            } else if ( 0 == strcmp(charName, "TOTAL_ERR_NONFATAL") ) {
+                aer->nonfatalTotal = uint64Val;
+            } else if ( 0 == strcmp(charName, "TOTAL_ERR_FATAL") ) {
+                aer->fatalTotal = uint64Val;
+            } else if ( 0 != i ) {
+                continue;   // only correctable errors are itemized
+            } else if ( 0 == strcmp(charName, "RxErr") ) {
+                aer->rxErr = uint64Val;
+            } else if ( 0 == strcmp(charName, "BadTLP") ) {
+                aer->badTlp = uint64Val;
+            } else if ( 0 == strcmp(charName, "BadDLLP") ) {
+                aer->badDllp = uint64Val;
+            } else if ( 0 == strcmp(charName, "Rollover") ) {
+                aer->replayRollover = uint64Val;
+            } else if ( 0 == strcmp(charName, "Timeout") ) {
+                aer->replayTimeout = uint64Val;
+            }
+        }
+        fclose(fptr);
+    }
+    /* no AER capability */
+    if ( 0 == uint8Found ) {
+        return -1;
+    }
+    return 0;
+}
+
+
+
+/**
+ *  pciinfoSleepMs
+ *    sleeps the interval, also beyond the range of usleep
+ */
+void pciinfoSleepMs(uint32_t ms, volatile sig_atomic_t *stop)
+{
+    struct timespec ts = {(time_t) (ms / 1000), (long) (ms % 1000) * 1000000L};
+
+    /* resume after signals until stop request */
+    while ( (0 != nanosleep(&ts, &ts)) && (EINTR == errno) && (NULL != stop) && (0 == *stop) ) {
+        ;
+    }
+}
+
+
+
+/**
+ *  pciinfo_aer_delta
+ *    counter increment, a decrease is a device reset and counts zero
+ */
+static uint64_t pciinfo_aer_delta(uint64_t end, uint64_t start, uint8_t *reset)
+{
+    if ( end < start ) {
+        *reset = 1;
+        return 0;
+    }
+    return end - start;
+}
+
+
+
+/**
+ *  pciinfoAerSample
+ *    AER rates of matching devices
+ */
+int pciinfoAerSample(const t_pciinfo_match *match, uint32_t intervalMs, double replayMax,
+                     double badTlpMax, t_pciinfo_aer_rate rate[], uint32_t rateValid, uint32_t rateMax)
+{
+    /** used variables **/
+    t_pciinfo_dev       *dev;
+    t_pciinfo_aer_rate  *prev;      // counters at interval start
+    t_pciinfo_aer_rate  *last;      // result of previous call
+    int                 intDevNum;
+    int                 intNum = 0;
+    uint32_t            uint32Last;
+    double              dblSec;
+    uint64_t            uint64Replay;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* matching devices */
+    if ( rateValid > rateMax ) {
+        rateValid = 0;
+    }
+    dev = calloc(rateMax, sizeof(*dev));
+    prev = calloc(rateMax, sizeof(*prev));
+    last = calloc(rateMax, sizeof(*last));
+    if ( (NULL == dev) || (NULL == prev) || (NULL == last) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        free(dev);
+        free(prev);
+        free(last);
+        return -1;
+    }
+    memcpy(last, rate, (size_t) rateValid * sizeof(*last));
+    intDevNum = pciinfo_enum(match, dev, rateMax);
+    /* counters at interval start: end of previous call or fresh, devices without AER are dropped */
+    uint32Last = 0;
+    for ( int i = 0; i < intDevNum; i++ ) {
+        while ( (uint32Last < rateValid) && (0 > strcmp(last[uint32Last].bdf, dev[i].bdf)) ) {
+            ++uint32Last;   // both in BDF order
+        }
+        if ( (uint32Last < rateValid) && (0 == strcmp(last[uint32Last].bdf, dev[i].bdf)) ) {
+            prev[intNum] = last[uint32Last];
+        } else {
+            if ( 0 != pciinfoAerRead(dev[i].path, &prev[intNum].aer) ) {
+                continue;
+            }
+            prev[intNum].ns = pciinfo_ns();
+        }
+        dev[intNum] = dev[i];
+        ++intNum;
+    }
+    if ( 0 != intervalMs ) {
+        pciinfoSleepMs(intervalMs, NULL);   // a signal ends it early, the rates use the measured time
+    }
+    /* counters at interval end */
+    for ( int i = 0; i < intNum; i++ ) {
+        memset(&rate[i], 0, sizeof(rate[i]));
+        strcpy(rate[i].bdf, dev[i].bdf);
+        if ( 0 != pciinfoAerRead(dev[i].path, &rate[i].aer) ) {
+            rate[i].aer = prev[i].aer;  // device removed, keep baseline
+            rate[i].ns = prev[i].ns;
+            continue;
+        }
+        rate[i].ns = pciinfo_ns();
+        dblSec = (double) (rate[i].ns - prev[i].ns) / 1e9;
+        if ( 0 >= dblSec ) {
+            continue;
+        }
+        rate[i].corPs = (double) pciinfo_aer_delta(rate[i].aer.corTotal, prev[i].aer.corTotal, &rate[i].reset) / dblSec;
+        rate[i].nonfatalPs = (double) pciinfo_aer_delta(rate[i].aer.nonfatalTotal, prev[i].aer.nonfatalTotal, &rate[i].reset) / dblSec;
+        rate[i].fatalPs = (double) pciinfo_aer_delta(rate[i].aer.fatalTotal, prev[i].aer.fatalTotal, &rate[i].reset) / dblSec;
+        uint64Replay = pciinfo_aer_delta(rate[i].aer.replayRollover, prev[i].aer.replayRollover, &rate[i].reset) +
+                       pciinfo_aer_delta(rate[i].aer.replayTimeout, prev[i].aer.replayTimeout, &rate[i].reset);
+        rate[i].replayPs = (double) uint64Replay / dblSec;
+        rate[i].badTlpPs = (double) pciinfo_aer_delta(rate[i].aer.badTlp, prev[i].aer.badTlp, &rate[i].reset) / dblSec;
+        /* reset: counters restarted within interval, no trustworthy rate */
+        if ( 0 != rate[i].reset ) {
+            rate[i].corPs = 0;
+            rate[i].nonfatalPs = 0;
+            rate[i].fatalPs = 0;
+            rate[i].replayPs = 0;
+            rate[i].badTlpPs = 0;
+            pciinfo_printf("  INFO:%s: '%s' counters decreased, re-baselined\n", __FUNCTION__, rate[i].bdf);
+        }
+        rate[i].alarm = (uint8_t) ((rate[i].replayPs > replayMax) || (rate[i].badTlpPs > badTlpMax));
+    }
+
+    /* finish function */
+    free(dev);
+    free(prev);
+    free(last);
+    return (0 > intDevNum) ? -1 : intNum;
+}
+
+
+
+/**
+ *  @brief  link power management attributes
+ *
+ *  in order of disabling, restore runs reverse
+ */
+static const char *g_pciinfoPmLink[] = {"link/l1_2_aspm", "link/l1_1_aspm", "link/l1_aspm", "link/l0s_aspm", "link/clkpm"};
+
+
+
+/**
+ *  pciinfo_pm_link
+ *    link attribute of state, same order as g_pciinfoPmLink
+ */
+static int8_t* pciinfo_pm_link(t_pciinfo_pm *pm, uint8_t idx)
+{
+    int8_t  *link[] = {&pm->l12Aspm, &pm->l11Aspm, &pm->l1Aspm, &pm->l0sAspm, &pm->clkpm};
+
+    return link[idx];
+}
 
-        /* process system call response */
-        if ( fscanf(foundDevice, "%s", line2) ) {    /* read only first line */
+
+
+/**
+ *  pciinfo_pm_set
+ *    applies power management state, link attributes below zero are skipped
+ */
+static int pciinfo_pm_set(const char sysPathPciDev[], t_pciinfo_pm *pm, int restore)
+{
+    char    charPath[PATH_MAX];
+    char    charVal[8];
+    int     intErr;
+    uint8_t idx;
+
+    /* runtime power management, sysfs replaces the value with each write, O_TRUNC is a no-op there */
+    snprintf(charPath, sizeof(charPath), "%s/power/control", sysPathPciDev);
+    intErr = pciinfo_sysfs_store(charPath, pm->control, O_TRUNC);
+    if ( 0 != intErr ) {
+        return intErr;
+    }
+    /* link states */
+    for ( uint8_t i = 0; i < sizeof(g_pciinfoPmLink) / sizeof(g_pciinfoPmLink[0]); i++ ) {
+        idx = (0 != restore) ? (uint8_t) (sizeof(g_pciinfoPmLink) / sizeof(g_pciinfoPmLink[0]) - 1 - i) : i;
+        if ( 0 > *pciinfo_pm_link(pm, idx) ) {
+            continue;
         }
-        if (0 == strcasecmp(line2, deviceID)) {
-            ++uint8FoundDevice;    /* increment match counter */
-            strncpy(devicePath, devPath, devicePathMax);
-            pciinfo_printf("vendor=%s/device=%s in '%s'\n", vendorID, line2, devPath);
+        snprintf(charPath, sizeof(charPath), "%s/%s", sysPathPciDev, g_pciinfoPmLink[idx]);
+        snprintf(charVal, sizeof(charVal), "%d", *pciinfo_pm_link(pm, idx));
+        intErr = pciinfo_sysfs_store(charPath, charVal, O_TRUNC);
+        if ( 0 != intErr ) {
+            return intErr;
         }
-
-        /* close opened pipe */
-        pclose(foundDevice);
     }
+    return 0;
+}
 
-    /* close opened pipe */
-    pclose(foundVendor);
 
-    /* finish function */
-    return (uint8FoundDevice - 1);
+
+/**
+ *  pciinfoPmGet
+ *    runtime power management and link ASPM state
+ */
+int pciinfoPmGet(const char sysPathPciDev[], t_pciinfo_pm *pm)
+{
+    /** used variables **/
+    char    charVal[16];
+    char    *base;
+
+    /* function call message */
+    pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
+
+    /* runtime power management */
+    memset(pm, 0, sizeof(*pm));
+    base = strrchr(sysPathPciDev, '/');
+    strncpy(pm->bdf, (NULL == base) ? sysPathPciDev : base + 1, sizeof(pm->bdf) - 1);
+    if ( 0 != pciinfo_sysfs_read(sysPathPciDev, "power/control", pm->control, sizeof(pm->control)) ) {
+        pciinfo_printf("  ERROR:%s: no power management for '%s'\n", __FUNCTION__, sysPathPciDev);
+        return -1;
+    }
+    pciinfo_sysfs_read(sysPathPciDev, "power/runtime_status", pm->runtimeStatus, sizeof(pm->runtimeStatus));
+    /* link states */
+    for ( uint8_t i = 0; i < sizeof(g_pciinfoPmLink) / sizeof(g_pciinfoPmLink[0]); i++ ) {
+        *pciinfo_pm_link(pm, i) = -1;
+        if ( 0 == pciinfo_sysfs_read(sysPathPciDev, g_pciinfoPmLink[i], charVal, sizeof(charVal)) ) {
+            *pciinfo_pm_link(pm, i) = (int8_t) (0 != strtol(charVal, NULL, 10));
+        }
+    }
+    return 0;
 }
 
 
 
 /**
- *  pciinfoBarExist
- *    check if bar is present
+ *  pciinfoPmOn
+ *    save state and disable power saving of matching functions
  */
-int pciinfoBarExist(const char sysPathPciDev[])
+int pciinfoPmOn(const t_pciinfo_match *match, const char stateFile[], t_pciinfo_pm pm[],
+                uint32_t pmMax)
 {
-    /** variables **/
-    int     intRet = 0;         // bit index indicates bar present y/n
-    char    charCmd[2048];      // string for buffering command
-    char    charResult[1024];   // command result one file line
-    FILE    *cmdResult;         // stored command result
-
+    /** used variables **/
+    t_pciinfo_dev   *dev;
+    t_pciinfo_pm    pmOn;
+    int             intNum;
+    int             intRet;
+    int             fd;
+    FILE            *fptr = NULL;
 
     /* function call message */
     pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
 
-    /* iterate over 6 possible bars */
-    for ( uint8_t i = 0; i < 6; i++ ) {
-        /*
-         *  build system call request for bar size
-         *    ls /sys/bus/pci/devices/0000:03:0d.0/resource*
-         */
-        snprintf(charCmd, sizeof(charCmd), "ls %s/resource%d 2>/dev/null", sysPathPciDev, i);
-        /* help message */
-        pciinfo_printf("  INFO:%s:BAR%d:CMD: %s\n", __FUNCTION__, i, charCmd);
-        /* execute command */
-        cmdResult = popen(charCmd, "r");
-        /* parse result */
-        while (EOF != fscanf(cmdResult, "%s", charResult)) {
-            /* debug */
-            pciinfo_printf("  INFO:%s:BAR%d:RESULT: %s\n", __FUNCTION__, i, charResult);
-            /* check length */
-            if ( 0 < strlen(charResult) ) {
-                intRet |= (int) (1<<i);     // bar is present
+    /* matching functions */
+    dev = calloc(pmMax, sizeof(*dev));
+    if ( NULL == dev ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    intNum = pciinfo_enum(match, dev, pmMax);
+    if ( 0 > intNum ) {
+        free(dev);
+        return -1;
+    }
+    /* previous state, never overwrite an existing one with the forced state */
+    if ( NULL != stateFile ) {
+        fd = open(stateFile, O_WRONLY | O_CREAT | O_EXCL, 0644);
+        fptr = (0 > fd) ? NULL : fdopen(fd, "w");
+        if ( NULL == fptr ) {
+            pciinfo_printf("  ERROR:%s: failed to create '%s', restore first if it exists.\n", __FUNCTION__, stateFile);
+            if ( 0 <= fd ) {
+                close(fd);
             }
+            free(dev);
+            return -1;
         }
-        /* close file handle */
-        pclose(cmdResult);
     }
-    /* return */
+    intRet = intNum;
+    for ( int i = 0; i < intNum; i++ ) {
+        if ( 0 != pciinfoPmGet(dev[i].path, &pm[i]) ) {
+            pm[i].err = ENOENT;
+            continue;
+        }
+        strcpy(pm[i].bdf, dev[i].bdf);
+        if ( NULL != fptr ) {
+            fprintf (   fptr, "%s %s %d %d %d %d %d\n", pm[i].bdf, pm[i].control,
+                        pm[i].l0sAspm, pm[i].l1Aspm, pm[i].l11Aspm, pm[i].l12Aspm, pm[i].clkpm
+                    );
+        }
+    }
+    if ( (NULL != fptr) && (0 != fclose(fptr)) ) {
+        pciinfo_printf("  ERROR:%s: failed to write '%s'.\n", __FUNCTION__, stateFile);
+        intRet = -1;
+    }
+    /* no autosuspend, no link power saving; only with saved state */
+    for ( int i = 0; (0 <= intRet) && (i < intNum); i++ ) {
+        if ( 0 != pm[i].err ) {
+            continue;
+        }
+        pmOn = pm[i];
+        strcpy(pmOn.control, "on");
+        for ( uint8_t j = 0; j < sizeof(g_pciinfoPmLink) / sizeof(g_pciinfoPmLink[0]); j++ ) {
+            if ( 0 < *pciinfo_pm_link(&pmOn, j) ) {
+                *pciinfo_pm_link(&pmOn, j) = 0;
+            } else {
+                *pciinfo_pm_link(&pmOn, j) = -1;    // absent or already off
+            }
+        }
+        pm[i].err = -pciinfo_pm_set(dev[i].path, &pmOn, 0);
+        if ( 0 == pm[i].err ) {
+            pciinfoPmGet(dev[i].path, &pm[i]);
+            strcpy(pm[i].bdf, dev[i].bdf);
+        }
+    }
+
+    /* finish function */
+    free(dev);
     return intRet;
 }
 
 
 
 /**
- *  pciinfoBarSize
- *    gets bar size from linux
+ *  pciinfoPmRestore
+ *    restore saved power management state
  */
-int pciinfoBarSize(const char sysPathPciDev[], uint8_t bar, uint32_t *byteSize)
+int pciinfoPmRestore(const char stateFile[])
 {
-
     /** used variables **/
-    char        charCmd[1024];              // string for buffering command
-    char        resultLine[1024];           // command result one file line
-    uint32_t    i;                          // iterator
-    FILE        *cmdResult;                 // stored command result
-
+    char            charPath[PCIINFO_PATH_MAX];
+    char            line[256];
+    t_pciinfo_pm    pm;
+    int             val[5];
+    int             intNum = 0;
+    int             intRet = 0;
+    FILE            *fptr;
 
     /* function call message */
     pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
 
-    /* check argument */
-    if ( bar > 5 ) {
-        pciinfo_printf("  ERROR:%s: Bar=%i exceeds max of 5\n", __FUNCTION__, bar);
+    /* saved state */
+    fptr = fopen(stateFile, "r");
+    if ( NULL == fptr ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, stateFile);
         return -1;
     }
+    /* '<bdf> <control> <l0s> <l1> <l1.1> <l1.2> <clkpm>' */
+    while ( NULL != fgets(line, sizeof(line), fptr) ) {
+        memset(&pm, 0, sizeof(pm));
+        if ( 7 != sscanf(line, "%15s %7s %d %d %d %d %d", pm.bdf, pm.control, &val[0], &val[1], &val[2], &val[3], &val[4]) ) {
+            continue;
+        }
+        pm.l0sAspm = (int8_t) val[0];
+        pm.l1Aspm = (int8_t) val[1];
+        pm.l11Aspm = (int8_t) val[2];
+        pm.l12Aspm = (int8_t) val[3];
+        pm.clkpm = (int8_t) val[4];
+        if ( (0 != pciinfo_dev_path(pm.bdf, charPath, sizeof(charPath))) || (0 != pciinfo_pm_set(charPath, &pm, 1)) ) {
+            pciinfo_printf("  ERROR:%s: failed to restore '%s'\n", __FUNCTION__, pm.bdf);
+            intRet = -1;
+            continue;
+        }
+        ++intNum;
+    }
+    fclose(fptr);
+    /* state consumed, allows next pciinfoPmOn */
+    if ( (0 == intRet) && (0 != unlink(stateFile)) ) {
+        pciinfo_printf("  ERROR:%s: failed to remove '%s'.\n", __FUNCTION__, stateFile);
+    }
 
-    /* init */
-    *byteSize = 0;
-    charCmd[0] = '\0';
+    /* finish function */
+    return (0 != intRet) ? -1 : intNum;
+}
 
-    /*  build system call request for bar size
-     *  ls -la /sys/bus/pci/devices/0000:03:0d.0/resource*
-     */
-    snprintf(charCmd, sizeof(charCmd), "ls -la %s/resource%d 2>/dev/null", sysPathPciDev, bar);
 
-    /* execute command */
-    cmdResult = popen(charCmd, "r");
 
-    /* process acquired data */
-    i = 0;
-    while (EOF != fscanf(cmdResult, "%s", resultLine)) {
-        /*  get fifth element in table, is file size
-         *  -rw------- 1 root root 32768 Feb 11 11:40 /sys/bus/pci/devices/0000:03:0d.0/resource0
-         */
-        if (4 == i) {
-            *byteSize = (uint32_t) strtol(resultLine, NULL, 10);
-            break;  // no further processing of string required after size extaction
+/**
+ *  pciinfo_fanout_worker
+ *    processes cards until the queue is empty
+ */
+static void* pciinfo_fanout_worker(void *arg)
+{
+    t_pciinfo_pool  *pool = (t_pciinfo_pool*) arg;
+    t_pciinfo_card  *card;
+    char            charBarFile[PCIINFO_PATH_MAX + 16];
+    uint32_t        idx;
+    uint64_t        uint64Start;
+
+    while ( (idx = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed)) < pool->num ) {
+        card = &pool->card[idx];
+        uint64Start = pciinfo_ns();
+        /* map selected BARs */
+        for ( uint8_t i = 0; (i < PCIINFO_BAR_NUM) && (0 == card->err); i++ ) {
+            if ( 0 == (pool->barMask & (1 << i)) ) {
+                continue;
+            }
+            if ( (size_t) snprintf(charBarFile, sizeof(charBarFile), "%s/resource%d", card->dev.path, i) >= sizeof(charBarFile) ) {
+                card->err = ENAMETOOLONG;
+                break;
+            }
+            errno = 0;
+            card->bar[i] = pciinfoBarMap(charBarFile, pool->writeable, &card->barSize[i]);
+            if ( NULL == card->bar[i] ) {
+                card->err = (0 != errno) ? errno : EINVAL;  // EINVAL: empty or IO BAR
+            }
         }
-        ++i;    // increment counter
+        card->ret = (0 == card->err) ? pool->fn(card, pool->arg) : -1;
+        /* release BARs */
+        for ( uint8_t i = 0; i < PCIINFO_BAR_NUM; i++ ) {
+            pciinfoBarUnmap(card->bar[i], card->barSize[i]);
+            card->bar[i] = NULL;
+            card->barSize[i] = 0;
+        }
+        card->ns = pciinfo_ns() - uint64Start;
     }
-
-    /* close file handle */
-    pclose(cmdResult);
-
-    /* finish function */
-    return 0;
+    return NULL;
 }
 
 
 
 /**
- *  pciinfoBarPath
- *  --------------
+ *  pciinfoFanout
+ *    runs callback on all matching devices in parallel
  */
-int pciinfoBarPath(const char vendorID[], const char deviceID[], uint8_t bar,
-                   char devicePath[], uint32_t devicePathMax)
+int pciinfoFanout(const t_pciinfo_match *match, uint8_t barMask, int writeable, uint32_t threads,
+                  t_pciinfo_fanout_fn fn, void *arg, t_pciinfo_card card[], uint32_t cardMax)
 {
     /** used variables **/
-    char    charBar[5];
-    FILE    *fptr;      // pointer to file
-
+    t_pciinfo_dev   *dev;
+    t_pciinfo_pool  pool;
+    pthread_t       *worker;
+    uint32_t        uint32Started = 0;
+    int             intDevNum;
 
     /* function call message */
     pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
 
-    /* find pci device */
-    devicePath[0] = '\0';
-    if (0 != pciinfoFind(vendorID, deviceID, devicePath, devicePathMax)) {
-        pciinfo_printf  (   "  ERROR:%s: Unable to find PCI Device with VendorID=%s and DeviceID=%s\n",
-                            __FUNCTION__, vendorID, deviceID
-                        );
+    /* check arguments */
+    if ( NULL == fn ) {
+        pciinfo_printf("  ERROR:%s: no callback\n", __FUNCTION__);
         return -1;
     }
-
-    /* build final path */
-    charBar[0] = '\0';
-    sprintf(charBar, "%d", bar);
-    strncat(devicePath, "/resource", (size_t) devicePathMax-1);
-    strncat(devicePath, charBar, (size_t) devicePathMax-1);
-
-    /*  check if file could be open */
-    fptr = fopen(devicePath, "r");
-    if (NULL == fptr) {
-        pciinfo_printf  (  "  ERROR:%s: File '%s' not found\n",
-                           __FUNCTION__, devicePath
-                        );
-        devicePath[0] = '\0';   // make invalid
-        return -1;              // failed
+    /* matching devices */
+    dev = calloc((0 == cardMax) ? 1 : cardMax, sizeof(*dev));
+    if ( NULL == dev ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
     }
-    fclose(fptr);   // close
+    intDevNum = pciinfo_enum(match, dev, cardMax);
+    for ( int i = 0; i < intDevNum; i++ ) {
+        memset(&card[i], 0, sizeof(card[i]));
+        card[i].dev = dev[i];
+    }
+    free(dev);
+    if ( 0 >= intDevNum ) {
+        return intDevNum;
+    }
+    /* work queue */
+    pool.card = card;
+    pool.num = (uint32_t) intDevNum;
+    atomic_init(&pool.next, 0);
+    pool.barMask = barMask;
+    pool.writeable = writeable;
+    pool.fn = fn;
+    pool.arg = arg;
+    /* start workers, not more than cards */
+    if ( 0 == threads ) {
+        threads = PCIINFO_FANOUT_THREADS;
+    }
+    if ( threads > pool.num ) {
+        threads = pool.num;
+    }
+    worker = calloc(threads, sizeof(*worker));
+    if ( NULL != worker ) {
+        for ( ; uint32Started < threads; uint32Started++ ) {
+            if ( 0 != pthread_create(&worker[uint32Started], NULL, pciinfo_fanout_worker, &pool) ) {
+                pciinfo_printf("  ERROR:%s: only %u of %u workers started\n", __FUNCTION__, uint32Started, threads);
+                break;
+            }
+        }
+    }
+    pciinfo_printf("  INFO:%s: %d devices on %u workers\n", __FUNCTION__, intDevNum, uint32Started);
+    /* caller helps, processes all cards if no worker started */
+    pciinfo_fanout_worker(&pool);
+    for ( uint32_t i = 0; i < uint32Started; i++ ) {
+        pthread_join(worker[i], NULL);
+    }
+    free(worker);
 
     /* finish function */
+    return intDevNum;
+}
+
+
+
+/**
+ *  pciinfo_dma_phys
+ *    resolves physical addresses of the buffer pages into the scatter list
+ */
+static int pciinfo_dma_phys(t_pciinfo_dma *dma)
+{
+    char        charPath[PCIINFO_PATH_MAX];
+    int         fd;
+    uint64_t    uint64Entry;
+    uint64_t    uint64Phy;
+    size_t      sysPage = (size_t) sysconf(_SC_PAGESIZE);
+
+    /* open pagemap */
+    if ( (size_t) snprintf(charPath, sizeof(charPath), "%s/self/pagemap", g_pciinfoProcRoot) >= sizeof(charPath) ) {
+        pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
+        return -1;
+    }
+    fd = open(charPath, O_RDONLY);
+    if ( 0 > fd ) {
+        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, charPath);
+        return -1;
+    }
+    /* one entry per page, pages are physically contiguous */
+    dma->segNum = 0;
+    for ( size_t off = 0; off < dma->size; off += dma->pageSize ) {
+        if ( sizeof(uint64Entry) != pread(fd, &uint64Entry, sizeof(uint64Entry),
+                                          (off_t) ((((uintptr_t) dma->virt + off) / sysPage) * sizeof(uint64Entry))) ) {
+            pciinfo_printf("  ERROR:%s: failed to read '%s'.\n", __FUNCTION__, charPath);
+            close(fd);
+            return -1;
+        }
+        /* bit 63: present, bit 0-54: page frame number */
+        uint64Phy = (uint64Entry & ((1ULL << 55) - 1)) * sysPage;
+        if ( (0 == (uint64Entry & (1ULL << 63))) || (0 == uint64Phy) ) {
+            pciinfo_printf("  ERROR:%s: page frame of offset 0x%zx hidden, requires CAP_SYS_ADMIN\n", __FUNCTION__, off);
+            close(fd);
+            return -1;
+        }
+        /* extend segment or start new one */
+        if ( (0 != dma->segNum) &&
+             (uint64Phy == (dma->seg[dma->segNum - 1].phyAdr + dma->seg[dma->segNum - 1].size)) ) {
+            dma->seg[dma->segNum - 1].size += dma->pageSize;
+        } else {
+            dma->seg[dma->segNum].phyAdr = uint64Phy;
+            dma->seg[dma->segNum].virtOff = off;
+            dma->seg[dma->segNum].size = dma->pageSize;
+            ++dma->segNum;
+        }
+    }
+    close(fd);
     return 0;
 }
 
 
 
 /**
- *  pciinfoBarPhyAdr
- *    get physical address of PCI bar
+ *  pciinfoDmaAlloc
+ *    hugepage backed, NUMA local, locked DMA buffer
  */
-int pciinfoBarPhyAdr(const char sysPathPciDev[], uint8_t barNo,
-                      uint32_t *barPhyAddr)
+int pciinfoDmaAlloc(const char sysPathPciDev[], size_t size, size_t pageSize, t_pciinfo_dma *dma)
 {
     /** used variables **/
-    char    sysPathTemp[1024] = {'\0'}; /* temporary buffer variable */
-    char    line[1023];                 /* read buffer */
-    uint8_t index;
-    FILE    *fptr;
+    char            charVal[16];
+    int             intFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+    long            lngNode = -1;
+    unsigned long   nodeMask[PCIINFO_NUMA_MAX / (8 * sizeof(unsigned long))];
 
     /* function call message */
     pciinfo_printf("__FUNCTION__ = %s\n", __FUNCTION__);
-    pciinfo_printf("  INFO:%s:DEVICE: '%s'.\n", __FUNCTION__, sysPathPciDev);
 
-    /* check for enough memory */
-    if ( (strlen(sysPathPciDev) + 10) > sizeof(sysPathTemp) ) {
+    /* page size */
+    memset(dma, 0, sizeof(*dma));
+    dma->node = -1;
+    if ( 0 == pageSize ) {
+        pageSize = PCIINFO_DMA_PAGE_2M;
+    }
+    if ( PCIINFO_DMA_PAGE_2M == pageSize ) {
+        intFlags |= MAP_HUGETLB | (21 << MAP_HUGE_SHIFT);
+    } else if ( PCIINFO_DMA_PAGE_1G == pageSize ) {
+        intFlags |= MAP_HUGETLB | (30 << MAP_HUGE_SHIFT);
+    } else {
+        pciinfo_printf("  ERROR:%s: unsupported page size 0x%zx, only hugepages\n", __FUNCTION__, pageSize);
+        return -1;
+    }
+    if ( 0 == size ) {
+        pciinfo_printf("  ERROR:%s: no size\n", __FUNCTION__);
+        return -1;
+    }
+    dma->pageSize = pageSize;
+    dma->size = (size + pageSize - 1) & ~(pageSize - 1);
+    /* reserve */
+    dma->seg = calloc(dma->size / pageSize, sizeof(*dma->seg));
+    if ( NULL == dma->seg ) {
         pciinfo_printf("  ERROR:%s: Not enough memory\n", __FUNCTION__);
         return -1;
     }
-
-    /*  build path to bar
-    *  before: /sys/bus/pci/devices/0000:04:0d.0/
-    *  after:  /sys/bus/pci/devices/0000:04:0d.0/resource
-    */
-    strncpy(sysPathTemp, sysPathPciDev, sizeof(sysPathTemp));
-    strncat(sysPathTemp, "/resource",  sizeof(sysPathTemp)-1);
-
-    /* open file handle */
-    fptr = fopen(sysPathTemp, "r");
-    if (NULL == fptr) {
-        pciinfo_printf("  ERROR:%s: failed to open '%s'.\n", __FUNCTION__, sysPathTemp);
+    dma->virt = mmap(NULL, dma->size, PROT_READ | PROT_WRITE, intFlags, -1, 0);
+    if ( MAP_FAILED == dma->virt ) {
+        pciinfo_printf("  ERROR:%s: no %zu byte with %zu byte pages, check 'nr_hugepages'\n", __FUNCTION__, dma->size, pageSize);
+        dma->virt = NULL;
+        pciinfoDmaFree(dma);
         return -1;
     }
-
-    /* iterate over all possible pci bars */
-    /* line number is the bar number */
-    for (index = 0; index < barNo; index++) {
-        if (NULL == fgets(line, sizeof(line), fptr)) {
-            pciinfo_printf("  ERROR:%s: bar %i not resent\n", __FUNCTION__, barNo);
-            fclose(fptr);
+    /* bind to device node before first touch */
+    if ( (NULL != sysPathPciDev) && (0 == pciinfo_sysfs_read(sysPathPciDev, "numa_node", charVal, sizeof(charVal))) ) {
+        lngNode = strtol(charVal, NULL, 10);
+    }
+    if ( (0 <= lngNode) && (PCIINFO_NUMA_MAX > lngNode) ) {
+        memset(nodeMask, 0, sizeof(nodeMask));
+        nodeMask[(unsigned long) lngNode / (8 * sizeof(unsigned long))] = 1UL << ((unsigned long) lngNode % (8 * sizeof(unsigned long)));
+        if ( 0 != syscall(SYS_mbind, dma->virt, dma->size, PCIINFO_MPOL_BIND, nodeMask, PCIINFO_NUMA_MAX + 1, PCIINFO_MPOL_MF_STRICT) ) {
+            pciinfo_printf("  ERROR:%s: failed to bind to NUMA node %ld\n", __FUNCTION__, lngNode);
+            pciinfoDmaFree(dma);
             return -1;
         }
+        dma->node = (int) lngNode;
     }
-    /* first column is the starting address of the bar */
-    if ( fscanf(fptr, "%x", barPhyAddr) ) {
+    /* fault in and pin */
+    if ( 0 != mlock(dma->virt, dma->size) ) {
+        pciinfo_printf("  ERROR:%s: failed to lock, check 'ulimit -l'\n", __FUNCTION__);
+        pciinfoDmaFree(dma);
+        return -1;
     }
-
-    /* close opened pipe */
-    fclose(fptr);
+    for ( size_t off = 0; off < dma->size; off += pageSize ) {
+        ((volatile uint8_t*) dma->virt)[off] = 0;
+    }
+    /* scatter list */
+    if ( 0 != pciinfo_dma_phys(dma) ) {
+        pciinfoDmaFree(dma);
+        return -1;
+    }
+    pciinfo_printf  (   "  INFO:%s: %zu byte on node %d in %u segments\n", __FUNCTION__,
+                        dma->size, dma->node, dma->segNum
+                    );
 
     /* finish function */
     return 0;
 }
+
+
+
+/**
+ *  pciinfoDmaContig
+ *    physically contiguous buffer
+ */
+int pciinfoDmaContig(const t_pciinfo_dma *dma)
+{
+    return (1 == dma->segNum) ? 1 : 0;
+}
+
+
+
+/**
+ *  pciinfoDmaFree
+ *    release DMA buffer
+ */
+void pciinfoDmaFree(t_pciinfo_dma *dma)
+{
+    if ( NULL != dma->virt ) {
+        munlock(dma->virt, dma->size);
+        munmap(dma->virt, dma->size);
+    }
+    free(dma->seg);
+    memset(dma, 0, sizeof(*dma));
+    dma->node = -1;
+}
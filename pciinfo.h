@@ -27,6 +27,311 @@
 
 
 
+/** Includes **/
+#include <stdint.h>     /* fixed data types, like uint32_t */
+#include <stddef.h>     /* size_t */
+#include <signal.h>     /* sig_atomic_t */
+#include <stdio.h>      /* FILE */
+
+
+
+/**
+ *  @defgroup PCIINFO_LIMITS
+ *  Defaults and static memory sizes of the library
+ *  @{
+ */
+#define PCIINFO_SYS_ROOT        "/sys"  /**< default mount point of sysfs */
+#define PCIINFO_PROC_ROOT       "/proc" /**< default mount point of procfs */
+#define PCIINFO_PATH_MAX        512     /**< maximum length of a system path */
+#define PCIINFO_BDF_MAX         16      /**< 'DDDD:BB:DD.F' and root complex names, incl. termination */
+#define PCIINFO_TREE_DEPTH      16      /**< maximum number of nodes between root complex and device */
+#define PCIINFO_DRV_MAX         64      /**< maximum length of a driver name */
+#define PCIINFO_NAMES_IDS       "/usr/share/misc/pci.ids"       /**< text PCI id database */
+#define PCIINFO_NAMES_DB        "/usr/share/misc/pci.ids.bin"   /**< compiled PCI id database, see pciinfoNamesCompile */
+#define PCIINFO_WATCH_RING      65536   /**< register samples in ring buffer between sampler and trace writer, power of two */
+#define PCIINFO_WATCH_MAGIC     "PCIWTR01"  /**< trace file identification, followed by t_pciinfo_sample records */
+#define PCIINFO_XFER_BLOCK      (1 << 20)   /**< block size of BAR dump, restore and diff */
+#define PCIINFO_XFER_LINE       64          /**< granularity of BAR diff */
+#define PCIINFO_CPULIST_MAX     256     /**< maximum length of a CPU list, f.e. '0-7,16-23' */
+#define PCIINFO_CPU_MAX         1024    /**< maximum number of CPUs */
+#define PCIINFO_BAR_NUM         6       /**< number of PCI BARs */
+#define PCIINFO_FANOUT_THREADS  8       /**< default worker threads of pciinfoFanout */
+#define PCIINFO_DMA_PAGE_2M     (1UL << 21) /**< 2 MiB hugepage */
+#define PCIINFO_DMA_PAGE_1G     (1UL << 30) /**< 1 GiB hugepage */
+/** @} */   // PCIINFO_LIMITS
+
+
+
+/**
+ *  @brief  PCI device
+ *
+ *  Node of the PCI topology, as resolved from the canonical sysfs path
+ *  of the device.
+ */
+typedef struct t_pciinfo_dev {
+    char        bdf[PCIINFO_BDF_MAX];   /**< domain:bus:device.function, f.e. '0000:03:0d.0' */
+    char        host[PCIINFO_BDF_MAX];  /**< root complex the device is attached to, f.e. 'pci0000:00' */
+    char        path[PCIINFO_PATH_MAX]; /**< canonical system path to the device */
+    uint16_t    vendor;                 /**< PCI vendor id */
+    uint16_t    device;                 /**< PCI device id */
+    uint16_t    subVendor;              /**< PCI subsystem vendor id */
+    uint16_t    subDevice;              /**< PCI subsystem device id */
+    uint32_t    class;                  /**< PCI class code */
+    int32_t     parent;                 /**< index of upstream bridge in device list, -1 if attached to root complex */
+    uint8_t     depth;                  /**< number of bridges between root complex and device */
+} t_pciinfo_dev;
+
+
+
+/**
+ *  @brief  PCI device filter
+ *
+ *  selects PCI devices, empty strings match all devices
+ */
+typedef struct t_pciinfo_match {
+    char    vendorID[8];            /**< PCI vendor id, f.e. '0x110a' */
+    char    deviceID[8];            /**< PCI device id, f.e. '0x4080' */
+    char    bdf[PCIINFO_BDF_MAX];   /**< BDF prefix, f.e. '0000:03' selects all devices on bus 3 */
+} t_pciinfo_match;
+
+
+
+/**
+ *  @brief  driver binding result
+ *
+ *  driver and IOMMU group of a PCI function, and timing and error
+ *  of the single steps of the driver binding.
+ */
+typedef struct t_pciinfo_bind {
+    char        bdf[PCIINFO_BDF_MAX];       /**< PCI function */
+    char        drvOld[PCIINFO_DRV_MAX];    /**< driver before binding, empty if unbound */
+    char        drvNew[PCIINFO_DRV_MAX];    /**< driver after binding, empty if unbound */
+    int32_t     iommuGroup;                 /**< IOMMU group, -1 if not assigned */
+    uint64_t    nsUnbind;                   /**< duration of 'driver/unbind' write */
+    uint64_t    nsOverride;                 /**< duration of 'driver_override' write */
+    uint64_t    nsBind;                     /**< duration of 'drivers/<drv>/bind' write */
+    const char  *errStep;                   /**< failed step, NULL if no error */
+    int         err;                        /**< errno of failed step, 0 if no error */
+} t_pciinfo_bind;
+
+
+
+/**
+ *  @brief  register sample
+ *
+ *  record of the '--watch' trace file, native byte order
+ */
+typedef struct t_pciinfo_sample {
+    uint64_t    ns;     /**< CLOCK_MONOTONIC time stamp in nanoseconds */
+    uint32_t    off;    /**< register offset in BAR */
+    uint32_t    val;    /**< register value */
+} t_pciinfo_sample;
+
+
+
+/**
+ *  @brief  register watch
+ *
+ *  configuration and result of pciinfoWatch
+ */
+typedef struct t_pciinfo_watch {
+    const char                  *barFile;   /**< BAR 'resourceN' or file-backed stand-in */
+    const uint32_t              *off;       /**< register offsets, 32bit aligned */
+    uint32_t                    offNum;     /**< number of register offsets */
+    uint32_t                    rateHz;     /**< sample rate of register list, 0 for busy poll */
+    uint64_t                    count;      /**< number of register list samples, 0 until stop */
+    uint8_t                     onlyChange; /**< log only changed register values */
+    const char                  *traceFile; /**< binary trace file */
+    volatile sig_atomic_t       *stop;      /**< stop request, f.e. from signal handler, could be NULL */
+    uint64_t                    sampled;    /**< out: sampled register list */
+    uint64_t                    logged;     /**< out: written samples */
+    uint64_t                    dropped;    /**< out: samples lost by ring buffer overflow */
+    uint64_t                    ns;         /**< out: duration of sampling */
+} t_pciinfo_watch;
+
+
+
+/**
+ *  @brief  BAR transfer statistic
+ *
+ *  result of BAR dump, restore and diff
+ */
+typedef struct t_pciinfo_xfer {
+    uint64_t    bytes;  /**< transferred bytes */
+    uint64_t    ns;     /**< duration of transfer */
+    uint64_t    lines;  /**< changed PCIINFO_XFER_LINE byte lines, only diff */
+} t_pciinfo_xfer;
+
+
+
+/**
+ *  @brief  interrupt vector
+ *
+ *  MSI/MSI-X or legacy interrupt of a PCI device
+ */
+typedef struct t_pciinfo_irq {
+    uint32_t    irq;                            /**< Linux IRQ number */
+    uint64_t    count;                          /**< interrupts summed over all CPUs */
+    uint64_t    *cpuCount;                      /**< interrupts per CPU column of /proc/interrupts, allocated by pciinfoIrqList */
+    uint32_t    cpuNum;                         /**< number of elements in 'cpuCount' */
+    char        affinity[PCIINFO_CPULIST_MAX];  /**< 'smp_affinity_list' */
+} t_pciinfo_irq;
+
+
+
+/**
+ *  @brief  AER counters
+ *
+ *  PCIe advanced error reporting statistic of 'aer_dev_correctable',
+ *  'aer_dev_nonfatal' and 'aer_dev_fatal'
+ */
+typedef struct t_pciinfo_aer {
+    uint64_t    corTotal;       /**< TOTAL_ERR_COR */
+    uint64_t    nonfatalTotal;  /**< TOTAL_ERR_NONFATAL */
+    uint64_t    fatalTotal;     /**< TOTAL_ERR_FATAL */
+    uint64_t    rxErr;          /**< RxErr, receiver error */
+    uint64_t    badTlp;         /**< BadTLP */
+    uint64_t    badDllp;        /**< BadDLLP */
+    uint64_t    replayRollover; /**< Rollover, REPLAY_NUM rollover */
+    uint64_t    replayTimeout;  /**< Timeout, replay timer timeout */
+} t_pciinfo_aer;
+
+
+
+/**
+ *  @brief  AER rates
+ *
+ *  per second deltas of the AER counters of one device
+ */
+typedef struct t_pciinfo_aer_rate {
+    char            bdf[PCIINFO_BDF_MAX];   /**< PCI function */
+    t_pciinfo_aer   aer;                    /**< counters at end of interval */
+    double          corPs;                  /**< correctable errors per second */
+    double          nonfatalPs;             /**< non-fatal errors per second */
+    double          fatalPs;                /**< fatal errors per second */
+    double          replayPs;               /**< replay rollover and timeout per second */
+    double          badTlpPs;               /**< bad TLPs per second */
+    uint8_t         alarm;                  /**< replay or bad TLP rate exceeds threshold */
+    uint8_t         reset;                  /**< counter decreased, device reset, rates of interval clamped */
+    uint64_t        ns;                     /**< monotonic time stamp of 'aer' */
+} t_pciinfo_aer_rate;
+
+
+
+/**
+ *  @brief  power management state
+ *
+ *  runtime power management and link ASPM state of a PCI function,
+ *  link states are -1 if the kernel does not expose them
+ */
+typedef struct t_pciinfo_pm {
+    char        bdf[PCIINFO_BDF_MAX];   /**< PCI function */
+    char        runtimeStatus[16];      /**< 'power/runtime_status', f.e. 'active', 'suspended' */
+    char        control[8];             /**< 'power/control', 'on' or 'auto' */
+    int8_t      l0sAspm;                /**< 'link/l0s_aspm' */
+    int8_t      l1Aspm;                 /**< 'link/l1_aspm' */
+    int8_t      l11Aspm;                /**< 'link/l1_1_aspm' */
+    int8_t      l12Aspm;                /**< 'link/l1_2_aspm' */
+    int8_t      clkpm;                  /**< 'link/clkpm' */
+    int         err;                    /**< errno of failed change, 0 if no error */
+} t_pciinfo_pm;
+
+
+
+/**
+ *  @brief  fan-out card
+ *
+ *  device handle passed to the pciinfoFanout callback, the same element
+ *  carries the result of the callback
+ */
+typedef struct t_pciinfo_card {
+    t_pciinfo_dev   dev;                        /**< PCI function */
+    void            *bar[PCIINFO_BAR_NUM];      /**< mapped BARs, NULL if absent or not mappable */
+    size_t          barSize[PCIINFO_BAR_NUM];   /**< size of mapping in byte */
+    uint64_t        result;                     /**< result value of callback */
+    int             ret;                        /**< return value of callback, 0: OK, -1 if BAR not mapped */
+    int             err;                        /**< errno of failed BAR mapping, callback not called */
+    uint64_t        ns;                         /**< runtime of callback incl. BAR mapping */
+} t_pciinfo_card;
+
+
+
+/**
+ *  @brief  fan-out callback
+ *
+ *  called once per matching device, runs concurrently on the worker threads
+ *
+ *  @param[in,out]  card    device handle with mapped BARs, stores result
+ *  @param[in]      arg     user argument of pciinfoFanout
+ *  @return         int     state, stored in card->ret
+ */
+typedef int (*t_pciinfo_fanout_fn)(t_pciinfo_card *card, void *arg);
+
+
+
+/**
+ *  @brief  scatter list element
+ *
+ *  physically contiguous part of a DMA buffer
+ */
+typedef struct t_pciinfo_seg {
+    uint64_t    phyAdr;     /**< physical start address */
+    uint64_t    virtOff;    /**< offset in buffer */
+    uint64_t    size;       /**< length in byte */
+} t_pciinfo_seg;
+
+
+
+/**
+ *  @brief  DMA buffer
+ *
+ *  hugepage backed, locked host memory with its scatter list
+ */
+typedef struct t_pciinfo_dma {
+    void            *virt;      /**< virtual address */
+    size_t          size;       /**< size in byte, multiple of pageSize */
+    size_t          pageSize;   /**< backing page size */
+    int             node;       /**< bound NUMA node, -1 if device has no node affinity */
+    t_pciinfo_seg   *seg;       /**< scatter list, sorted by buffer offset */
+    uint32_t        segNum;     /**< number of elements in 'seg' */
+} t_pciinfo_dma;
+
+
+
+/**
+ *  @brief  set sysfs root
+ *
+ *  changes the sysfs mount point used by the library, f.e. to
+ *  operate on a synthetic sysfs tree
+ *
+ *  @param[in]  sysRoot     path to sysfs root, NULL restores PCIINFO_SYS_ROOT
+ *  @return     int         state
+ *  @retval     0           OK
+ *  @retval     -1          FAIL, path too long
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoSysRoot(const char sysRoot[]);
+
+
+
+/**
+ *  @brief  set procfs root
+ *
+ *  changes the procfs mount point used by the library, f.e. to
+ *  operate on a synthetic tree
+ *
+ *  @param[in]  procRoot    path to procfs root, NULL restores PCIINFO_PROC_ROOT
+ *  @return     int         state
+ *  @retval     0           OK
+ *  @retval     -1          FAIL, path too long
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoProcRoot(const char procRoot[]);
+
+
+
 /**
  *  @brief  PCI device root dir in file system
  *
@@ -119,5 +424,578 @@ int pciinfoBarPath(const char vendorID[], const char deviceID[], uint8_t bar,
 int pciinfoBarPhyAdr(const char sysPathPciDev[], uint8_t barNo,
                       uint32_t *barPhyAddr);
 
+
+
+/**
+ *  @brief  PCI topology
+ *
+ *  enumerates all PCI devices and resolves the bridges and switch ports
+ *  between root complex and device into a parent/child tree. The list
+ *  is sorted in BDF order.
+ *
+ *  @param[out] dev         device list
+ *  @param[in]  devMax      maximal number of elements in 'dev'
+ *  @return     int         number of found devices
+ *  @retval     -1          FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoTopo(t_pciinfo_dev dev[], uint32_t devMax);
+
+
+
+/**
+ *  @brief  distance between two PCI devices
+ *
+ *  counts the links between two devices on the path over their
+ *  common upstream bridge. Devices attached to different root
+ *  complexes are connected over the host, in this case is the
+ *  ancestor empty.
+ *
+ *  @param[in]  devA            BDF or system path of first device
+ *  @param[in]  devB            BDF or system path of second device
+ *  @param[out] ancestor        common bridge or root complex, could be NULL
+ *  @param[in]  ancestorMax     maximal length of 'ancestor'
+ *  @return     int             hop distance
+ *  @retval     0               same device
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoDistance(const char devA[], const char devB[], char ancestor[],
+                    uint32_t ancestorMax);
+
+
+
+/**
+ *  @brief  matching PCI devices
+ *
+ *  enumerates all PCI devices which pass the filter, sorted in BDF order
+ *
+ *  @param[in]  match       device filter, NULL selects all devices
+ *  @param[out] dev         device list, 'parent' and 'depth' are not resolved
+ *  @param[in]  devMax      maximal number of elements in 'dev'
+ *  @return     int         number of matching devices
+ *  @retval     -1          FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoMatch(const t_pciinfo_match *match, t_pciinfo_dev dev[], uint32_t devMax);
+
+
+
+/**
+ *  @brief  bound driver
+ *
+ *  name of the driver the PCI function is bound to
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device
+ *  @param[out] driver          driver name, empty if unbound
+ *  @param[in]  driverMax       maximal length of 'driver'
+ *  @return     int             state
+ *  @retval     0               OK
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoDriver(const char sysPathPciDev[], char driver[], uint32_t driverMax);
+
+
+
+/**
+ *  @brief  IOMMU group
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device
+ *  @return     int             IOMMU group number
+ *  @retval     -1              no IOMMU group assigned
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoIommuGroup(const char sysPathPciDev[]);
+
+
+
+/**
+ *  @brief  batch driver binding
+ *
+ *  binds all matching PCI functions to the given driver. For every
+ *  function the current driver is unbound, the 'driver_override' is
+ *  set and the function is bound to the new driver. Functions already
+ *  bound to the driver are skipped. Without driver only the current
+ *  driver and IOMMU group is reported.
+ *
+ *  @param[in]  match       device filter, NULL selects all devices
+ *  @param[in]  driver      new driver, f.e. 'vfio-pci', NULL for report only
+ *  @param[out] bind        per function result, sorted in BDF order
+ *  @param[in]  bindMax     maximal number of elements in 'bind'
+ *  @return     int         number of processed functions
+ *  @retval     -1          FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoBind(const t_pciinfo_match *match, const char driver[],
+                t_pciinfo_bind bind[], uint32_t bindMax);
+
+
+
+/**
+ *  @brief  compile PCI id database
+ *
+ *  converts the text 'pci.ids' into a hash table of vendor, device
+ *  and subsystem keys with offsets into a single string blob. The
+ *  result is memory mapped by pciinfoNamesOpen without any parsing.
+ *  The database is written to a temporary file beside 'dbFile' and
+ *  renamed over it when complete. A file without names fails.
+ *
+ *  @param[in]  idsFile     text database, NULL for PCIINFO_NAMES_IDS
+ *  @param[in]  dbFile      compiled database, NULL for PCIINFO_NAMES_DB
+ *  @return     int         number of database entries
+ *  @retval     -1          FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoNamesCompile(const char idsFile[], const char dbFile[]);
+
+
+
+/**
+ *  @brief  open PCI id database
+ *
+ *  memory maps the compiled database for name lookups, the open checks
+ *  only the header and the blob termination, name offsets are checked on
+ *  lookup
+ *
+ *  @param[in]  dbFile      compiled database, NULL for PCIINFO_NAMES_DB
+ *  @return     int         state
+ *  @retval     0           OK
+ *  @retval     -1          FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoNamesOpen(const char dbFile[]);
+
+
+
+/**
+ *  @brief  close PCI id database
+ *
+ *  @return     none
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+void pciinfoNamesClose(void);
+
+
+
+/**
+ *  @brief  vendor name
+ *
+ *  @param[in]  vendor      PCI vendor id
+ *  @return     const char* vendor name, NULL if unknown
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+const char* pciinfoNameVendor(uint16_t vendor);
+
+
+
+/**
+ *  @brief  device name
+ *
+ *  @param[in]  vendor      PCI vendor id
+ *  @param[in]  device      PCI device id
+ *  @return     const char* device name, NULL if unknown
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+const char* pciinfoNameDevice(uint16_t vendor, uint16_t device);
+
+
+
+/**
+ *  @brief  subsystem name
+ *
+ *  @param[in]  vendor      PCI vendor id
+ *  @param[in]  device      PCI device id
+ *  @param[in]  subVendor   PCI subsystem vendor id
+ *  @param[in]  subDevice   PCI subsystem device id
+ *  @return     const char* subsystem name, NULL if unknown
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+const char* pciinfoNameSubsys(uint16_t vendor, uint16_t device, uint16_t subVendor,
+                              uint16_t subDevice);
+
+
+
+/**
+ *  @brief  map BAR
+ *
+ *  memory maps the BAR 'resourceN' file of the PCI device, or a file-backed
+ *  stand-in with the same layout
+ *
+ *  @param[in]  barFile     path to BAR 'resourceN' or stand-in
+ *  @param[in]  writeable   0: read-only mapping, otherwise read/write
+ *  @param[out] size        size of mapping in byte
+ *  @return     void*       mapped BAR
+ *  @retval     NULL        FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+void* pciinfoBarMap(const char barFile[], int writeable, size_t *size);
+
+
+
+/**
+ *  @brief  unmap BAR
+ *
+ *  @param[in]  bar         mapped BAR
+ *  @param[in]  size        size of mapping in byte
+ *  @return     none
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+void pciinfoBarUnmap(void *bar, size_t size);
+
+
+
+/**
+ *  @brief  watch BAR registers
+ *
+ *  samples a list of 32bit registers with the given rate and time stamps
+ *  every sample with the monotonic clock. The samples are passed through a
+ *  lock-free single producer ring buffer to a writer thread which drains
+ *  them into the binary trace file. The trace starts with PCIINFO_WATCH_MAGIC
+ *  followed by t_pciinfo_sample records. Missed periods are skipped, the
+ *  next sample is taken at the next future period boundary. Rates above
+ *  1 GHz are rejected.
+ *
+ *  @param[in,out]  watch   configuration and statistic
+ *  @return         int     state
+ *  @retval         0       OK
+ *  @retval         -1      FAIL
+ *  @since          2026-10-18
+ *  @author         Andreas Kaeberlein
+ */
+int pciinfoWatch(t_pciinfo_watch *watch);
+
+
+
+/**
+ *  @brief  dump BAR
+ *
+ *  copies a BAR range with aligned 64bit loads in blocks of
+ *  PCIINFO_XFER_BLOCK into a file. The range is bounded by pciinfoBarSize.
+ *  A partial image is removed on failure.
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device
+ *  @param[in]  bar             PCI bar number
+ *  @param[in]  off             start offset in BAR, 64bit aligned
+ *  @param[in]  len             number of bytes, multiple of 8, 0 until end of BAR
+ *  @param[in]  file            BAR image
+ *  @param[out] xfer            transfer statistic, could be NULL
+ *  @return     int             state
+ *  @retval     0               OK
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoBarDump(const char sysPathPciDev[], uint8_t bar, uint64_t off, uint64_t len,
+                   const char file[], t_pciinfo_xfer *xfer);
+
+
+
+/**
+ *  @brief  restore BAR
+ *
+ *  writes a saved BAR image with aligned 64bit stores in blocks of
+ *  PCIINFO_XFER_BLOCK back into the BAR
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device
+ *  @param[in]  bar             PCI bar number
+ *  @param[in]  off             start offset in BAR, 64bit aligned
+ *  @param[in]  file            BAR image, size multiple of 8
+ *  @param[out] xfer            transfer statistic, could be NULL
+ *  @return     int             state
+ *  @retval     0               OK
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoBarRestore(const char sysPathPciDev[], uint8_t bar, uint64_t off,
+                      const char file[], t_pciinfo_xfer *xfer);
+
+
+
+/**
+ *  @brief  diff BAR
+ *
+ *  compares a BAR image against a second image or against the live BAR
+ *  contents and reports the changed PCIINFO_XFER_LINE byte lines
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device, unused with 'fileB'
+ *  @param[in]  bar             PCI bar number
+ *  @param[in]  off             BAR offset of the images, 64bit aligned
+ *  @param[in]  fileA           BAR image
+ *  @param[in]  fileB           second BAR image, NULL for live BAR
+ *  @param[in]  report          changed lines output, could be NULL
+ *  @param[out] xfer            transfer statistic, could be NULL
+ *  @return     int             number of changed lines
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoBarDiff(const char sysPathPciDev[], uint8_t bar, uint64_t off, const char fileA[],
+                   const char fileB[], FILE *report, t_pciinfo_xfer *xfer);
+
+
+
+/**
+ *  @brief  interrupt vectors
+ *
+ *  lists the MSI/MSI-X vectors of the device from 'msi_irqs/', or the
+ *  legacy interrupt, joined with the per CPU counts of '/proc/interrupts'
+ *  and the current 'smp_affinity_list'. The per CPU counts are allocated
+ *  with the number of CPU columns, 'irq' needs to be zero initialized before
+ *  the first call and released with pciinfoIrqFree. With 'irq' NULL only
+ *  the vectors are counted.
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device
+ *  @param[out] irq             interrupt vectors, sorted by IRQ number
+ *  @param[in]  irqMax          maximal number of elements in 'irq'
+ *  @return     int             number of interrupt vectors
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoIrqList(const char sysPathPciDev[], t_pciinfo_irq irq[], uint32_t irqMax);
+
+
+
+/**
+ *  @brief  spread interrupt vectors
+ *
+ *  assigns the interrupt vectors round robin to the CPUs of the
+ *  device-local NUMA node ('local_cpulist'), one CPU per vector
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device
+ *  @param[out] irq             interrupt vectors after applied plan
+ *  @param[in]  irqMax          maximal number of elements in 'irq'
+ *  @return     int             number of interrupt vectors
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoIrqSpread(const char sysPathPciDev[], t_pciinfo_irq irq[], uint32_t irqMax);
+
+
+
+/**
+ *  @brief  release interrupt vectors
+ *
+ *  frees the per CPU counts allocated by pciinfoIrqList, the array
+ *  itself is owned by the caller
+ *
+ *  @param[in,out]  irq     interrupt vectors
+ *  @param[in]      irqMax  number of elements in 'irq'
+ *  @return         none
+ *  @since          2026-10-18
+ *  @author         Andreas Kaeberlein
+ */
+void pciinfoIrqFree(t_pciinfo_irq irq[], uint32_t irqMax);
+
+
+
+/**
+ *  @brief  AER counters
+ *
+ *  reads 'aer_dev_correctable', 'aer_dev_nonfatal' and 'aer_dev_fatal'
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device
+ *  @param[out] aer             AER counters
+ *  @return     int             state
+ *  @retval     0               OK
+ *  @retval     -1              FAIL, no AER capability
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoAerRead(const char sysPathPciDev[], t_pciinfo_aer *aer);
+
+
+
+/**
+ *  @brief  AER rates
+ *
+ *  reads the AER counters of all matching devices before and after the
+ *  interval and computes the per second rates. Devices of the previous
+ *  call continue with its end counters, so no error between two calls is
+ *  lost. Decreasing counters are taken as device reset, the rates are
+ *  clamped to zero and the device re-baselined. Devices without AER
+ *  capability are skipped.
+ *
+ *  @param[in]  match           device filter, NULL selects all devices
+ *  @param[in]  intervalMs      sample interval in ms
+ *  @param[in]  replayMax       replay rate threshold per second
+ *  @param[in]  badTlpMax       bad TLP rate threshold per second
+ *  @param[in,out] rate         per device rates, sorted in BDF order, in: previous call
+ *  @param[in]  rateValid       elements in 'rate' from previous call, 0 for first call
+ *  @param[in]  rateMax         maximal number of elements in 'rate'
+ *  @return     int             number of devices with AER
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoAerSample(const t_pciinfo_match *match, uint32_t intervalMs, double replayMax,
+                     double badTlpMax, t_pciinfo_aer_rate rate[], uint32_t rateValid, uint32_t rateMax);
+
+
+
+/**
+ *  @brief  sleep
+ *
+ *  sleeps the interval, also for intervals beyond the range of usleep.
+ *  A signal ends the sleep early if 'stop' is NULL or set, otherwise
+ *  the remaining interval is slept.
+ *
+ *  @param[in]  ms          interval in ms
+ *  @param[in]  stop        stop request, f.e. from signal handler, could be NULL
+ *  @return     none
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+void pciinfoSleepMs(uint32_t ms, volatile sig_atomic_t *stop);
+
+
+
+/**
+ *  @brief  power management state
+ *
+ *  reads 'power/runtime_status', 'power/control' and the link ASPM state
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device
+ *  @param[out] pm              power management state
+ *  @return     int             state
+ *  @retval     0               OK
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoPmGet(const char sysPathPciDev[], t_pciinfo_pm *pm);
+
+
+
+/**
+ *  @brief  disable power saving
+ *
+ *  saves the power management state of all matching functions into the
+ *  state file, sets 'power/control' to 'on' and disables link ASPM and
+ *  clock power management. An existing state file is not overwritten,
+ *  the call fails until it is restored.
+ *
+ *  @param[in]  match       device filter, NULL selects all devices
+ *  @param[in]  stateFile   saved state for pciinfoPmRestore, could be NULL
+ *  @param[out] pm          state after change, sorted in BDF order
+ *  @param[in]  pmMax       maximal number of elements in 'pm'
+ *  @return     int         number of processed functions
+ *  @retval     -1          FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoPmOn(const t_pciinfo_match *match, const char stateFile[], t_pciinfo_pm pm[],
+                uint32_t pmMax);
+
+
+
+/**
+ *  @brief  restore power management
+ *
+ *  restores the settings saved by pciinfoPmOn, the state file is removed
+ *  if all functions are restored
+ *
+ *  @param[in]  stateFile   saved state
+ *  @return     int         number of restored functions
+ *  @retval     -1          FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoPmRestore(const char stateFile[]);
+
+
+
+/**
+ *  @brief  fan-out operation
+ *
+ *  runs the callback for every matching device on a pool of worker threads.
+ *  Before the call the selected BARs of the device are mapped, afterwards
+ *  released. If a selected BAR is not mappable the callback is skipped and
+ *  the errno recorded. The results are stored per device in BDF order, a
+ *  failing device does not stop the others.
+ *
+ *  @param[in]  match       device filter, NULL selects all devices
+ *  @param[in]  barMask     BARs to map, bit i selects BAR i
+ *  @param[in]  writeable   0: read-only BAR mappings, otherwise read/write
+ *  @param[in]  threads     number of worker threads, 0 selects PCIINFO_FANOUT_THREADS
+ *  @param[in]  fn          callback
+ *  @param[in]  arg         user argument passed to callback
+ *  @param[out] card        per device handles and results, sorted in BDF order
+ *  @param[in]  cardMax     maximal number of elements in 'card'
+ *  @return     int         number of processed devices
+ *  @retval     -1          FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoFanout(const t_pciinfo_match *match, uint8_t barMask, int writeable, uint32_t threads,
+                  t_pciinfo_fanout_fn fn, void *arg, t_pciinfo_card card[], uint32_t cardMax);
+
+
+
+/**
+ *  @brief  allocate DMA buffer
+ *
+ *  reserves a hugepage backed buffer, binds it to the NUMA node of the
+ *  PCI device, locks it into memory and resolves the physical addresses
+ *  via '/proc/self/pagemap' into the scatter list. Resolving requires
+ *  CAP_SYS_ADMIN, otherwise the kernel hides the page frames.
+ *
+ *  @param[in]  sysPathPciDev   system path to PCI device for NUMA node, NULL for no binding,
+ *                              fails if the device has a node and binding is impossible
+ *  @param[in]  size            buffer size, rounded up to page size
+ *  @param[in]  pageSize        PCIINFO_DMA_PAGE_2M, PCIINFO_DMA_PAGE_1G, 0 selects 2 MiB,
+ *                              other sizes fail, small pages are not DMA-safe
+ *  @param[out] dma             DMA buffer
+ *  @return     int             state
+ *  @retval     0               OK
+ *  @retval     -1              FAIL
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoDmaAlloc(const char sysPathPciDev[], size_t size, size_t pageSize, t_pciinfo_dma *dma);
+
+
+
+/**
+ *  @brief  check DMA buffer contiguity
+ *
+ *  @param[in]  dma             DMA buffer
+ *  @return     int             contiguity
+ *  @retval     1               physically contiguous, one scatter list element
+ *  @retval     0               scattered
+ *  @since      2026-10-18
+ *  @author     Andreas Kaeberlein
+ */
+int pciinfoDmaContig(const t_pciinfo_dma *dma);
+
+
+
+/**
+ *  @brief  release DMA buffer
+ *
+ *  @param[in,out]  dma         DMA buffer
+ *  @return         none
+ *  @since          2026-10-18
+ *  @author         Andreas Kaeberlein
+ */
+void pciinfoDmaFree(t_pciinfo_dma *dma);
+
 //--------------------------------------------------------------
 #endif // __PCIINFO_H
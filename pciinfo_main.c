@@ -26,8 +26,11 @@
 #include <stdint.h>         // defines fiexd data types, like int8_t...
 #include <unistd.h>         // system call wrapper functions such as fork, pipe and I/O primitives (read, write, close, etc.).
 #include <string.h>         // string handling functions
+#include <strings.h>        // strncasecmp
 #include <ctype.h>          // toupper
 #include <getopt.h>         // CLI parser
+#include <signal.h>         // stop watch with Ctrl-C
+#include <time.h>           // time stamp of AER samples, nanosleep
 
 
 /** User Libs **/
@@ -54,10 +57,28 @@
  */
 #define DEF_SET_VID         "0x110A"    /**< Siemens Vendor ID */
 #define DEF_SET_DID         "0x4080"    /**< NC FPGA Device ID */
+#define DEF_SET_DEV_MAX     1024        /**< maximum number of handled PCI devices */
+#define DEF_SET_WATCH_RATE  1000        /**< register watch sample rate in Hz */
+#define DEF_SET_WATCH_REGS  64          /**< maximum number of watched registers */
+#define DEF_SET_TRACE       "pciinfo.trace" /**< register watch trace file */
+#define DEF_SET_IMAGE       "bar.img"   /**< BAR dump image */
+#define DEF_SET_IRQ_MS      1000        /**< interrupt rate sample interval in ms */
+#define DEF_SET_AER_MS      1000        /**< AER sample interval in ms */
+#define DEF_SET_AER_REPLAY  1.0         /**< AER replay rate threshold per second */
+#define DEF_SET_AER_BADTLP  1.0         /**< AER bad TLP rate threshold per second */
 /** @} */   // DEFAULT_SETTINGS
 
 
 
+/**
+ *  @brief  stop request
+ *
+ *  set by SIGINT to finish the register watch
+ */
+static volatile sig_atomic_t g_stop = 0;
+
+
+
 /**
  *  help
  */
@@ -82,6 +103,38 @@ void help( char prog[] )
     printf("  -a, --adr=[<barNum>]       List physical BAR adresses of existing BARs, or for a single BAR\n");
     printf("  -s, --size=[<barNum>]      List BAR sizes for all or a single BAR\n");
     printf("  -b, --bus                  Get PCI bus and function\n");
+    printf("      --tree                 List PCI topology of bridges, switch ports and devices\n");
+    printf("      --dist=<bdf>           Hop distance and common bridge to the given device\n");
+    printf("      --root=<dir>           sysfs root, f.e. synthetic tree {%s}\n", PCIINFO_SYS_ROOT);
+    printf("      --bdf=<prefix>         Restrict multi device operations to BDF prefix, f.e. '0000:03'\n");
+    printf("      --iommu                List driver and IOMMU group of all VID/DID matches\n");
+    printf("      --bind=<drv>           Bind all VID/DID matches to driver, f.e. 'vfio-pci'\n");
+    printf("      --watch=<bar>:<off>[,<off>...]  Sample BAR registers into trace file, Ctrl-C stops\n");
+    printf("      --rate=<hz>            Register watch sample rate, 0 busy poll {%d}\n", DEF_SET_WATCH_RATE);
+    printf("      --count=<num>          Number of register watch samples, 0 until Ctrl-C {0}\n");
+    printf("      --changes              Register watch logs only changed values\n");
+    printf("      --trace=<file>         Register watch trace file {%s}\n", DEF_SET_TRACE);
+    printf("      --file=<path>          File-backed stand-in for the BAR of register watch\n");
+    printf("      --dump=<bar>[:<off>[:<len>]]  Dump BAR range into image\n");
+    printf("      --restore=<bar>[:<off>]   Restore image into BAR\n");
+    printf("      --diff=<bar>[:<off>]   Changed 64 byte lines between image and live BAR\n");
+    printf("      --image=<file>         BAR image of dump, restore and diff {%s}\n", DEF_SET_IMAGE);
+    printf("      --ref=<file>           Diff image against this dump instead of live BAR\n");
+    printf("      --irq=[<ms>]           List interrupt vectors, affinity and rate over interval {%d}\n", DEF_SET_IRQ_MS);
+    printf("      --irq-spread           Spread interrupt vectors over device-local CPUs\n");
+    printf("      --aer=[<ms>]           Sample AER error rates of all VID/DID matches {%d}\n", DEF_SET_AER_MS);
+    printf("      --aer-max=<replay>[,<badtlp>]  AER alarm thresholds per second {%.1f,%.1f}\n", DEF_SET_AER_REPLAY, DEF_SET_AER_BADTLP);
+    printf("      --aer-count=<num>      Number of AER samples, 0 until Ctrl-C {0}\n");
+    printf("      --pm                   List runtime power management and ASPM of all VID/DID matches\n");
+    printf("      --pm-on=<state>        Disable autosuspend and ASPM of all VID/DID matches, save previous state\n");
+    printf("      --pm-restore=<state>   Restore power management from saved state\n");
+    printf("      --fanout=<bar>:<off>   Read 32bit register of all VID/DID matches in parallel\n");
+    printf("      --threads=<num>        Worker threads of fan-out {%d}\n", PCIINFO_FANOUT_THREADS);
+    printf("      --dma=<size>[:<page>]  Allocate locked hugepage buffer near device, list scatter list {0x%lx}\n", PCIINFO_DMA_PAGE_2M);
+    printf("                             page 0x%lx or 0x%lx, no fallback to small pages\n", PCIINFO_DMA_PAGE_2M, PCIINFO_DMA_PAGE_1G);
+    printf("                             demo only, buffer is freed on exit, addresses are invalid afterwards\n");
+    printf("      --proc=<dir>           procfs root, f.e. synthetic tree {%s}\n", PCIINFO_PROC_ROOT);
+    printf("      --names=[<db>]         Vendor/device names from compiled pci.ids {%s}\n", PCIINFO_NAMES_DB);
     printf("      --brief                output in shell evaluable format\n");
     printf("      --verbose              advanced outputs\n");
     printf("\n\n");
@@ -112,6 +165,191 @@ void touppers(char* s) {
 
 
 
+/**
+ *  @brief sigint
+ *
+ *  requests stop of the register watch
+ *
+ *  @param[in]      sig             signal number
+ *  @return         none
+ *  @since          October 18, 2026
+ */
+void sigint(int sig)
+{
+    (void) sig;
+    g_stop = 1;
+}
+
+
+
+/**
+ *  @brief parse_bar_range
+ *
+ *  parses '<bar>[:<off>[:<len>]]'
+ *
+ *  @param[in]      arg             CLI argument
+ *  @param[out]     bar             PCI bar number
+ *  @param[out]     off             BAR offset, 0 if not given
+ *  @param[out]     len             range length, 0 if not given
+ *  @return         int             state
+ *  @retval         0               OK
+ *  @retval         -1              FAIL
+ *  @since          October 18, 2026
+ */
+int parse_bar_range(const char arg[], int8_t *bar, uint64_t *off, uint64_t *len)
+{
+    char    *end;
+    long    lngBar;
+
+    *off = 0;
+    *len = 0;
+    lngBar = strtol(arg, &end, 10);
+    if ( (end == arg) || (0 > lngBar) || (5 < lngBar) ) {
+        return -1;
+    }
+    *bar = (int8_t) lngBar;
+    if ( ':' == *end ) {
+        *off = (uint64_t) strtoull(end + 1, &end, 0);
+    }
+    if ( ':' == *end ) {
+        *len = (uint64_t) strtoull(end + 1, &end, 0);
+    }
+    return ('\0' == *end) ? 0 : -1;
+}
+
+
+
+/**
+ *  @brief print_xfer
+ *
+ *  prints BAR transfer statistic
+ *
+ *  @param[in]      msgLevel        output message level
+ *  @param[in]      job             transfer kind, f.e. 'DUMP'
+ *  @param[in]      xfer            transfer statistic
+ *  @return         none
+ *  @since          October 18, 2026
+ */
+void print_xfer(int msgLevel, const char job[], const t_pciinfo_xfer *xfer)
+{
+    double  dblMibs = (0 == xfer->ns) ? 0.0 : ((double) xfer->bytes / (1024.0 * 1024.0)) / ((double) xfer->ns / 1e9);
+
+    if ( MSG_LEVEL_NORM <= msgLevel ) {
+        printf("             %lu byte in %.3f ms, %.1f MiB/s\n", (unsigned long) xfer->bytes, (double) xfer->ns / 1e6, dblMibs);
+    } else {
+        printf("PCIINFO_%s_BYTES=%lu\n", job, (unsigned long) xfer->bytes);
+        printf("PCIINFO_%s_MIBS=%.1f\n", job, dblMibs);
+    }
+}
+
+
+
+/**
+ *  @brief fan-out register
+ *
+ *  register read by fanout_read32
+ */
+typedef struct t_fanout_reg {
+    int8_t      bar;    /**< PCI bar */
+    uint64_t    off;    /**< register offset */
+} t_fanout_reg;
+
+
+
+/**
+ *  @brief fanout_read32
+ *
+ *  fan-out callback, reads one 32bit register
+ *
+ *  @param[in,out]  card            device handle, result holds register value
+ *  @param[in]      arg             register, t_fanout_reg
+ *  @return         int             state
+ *  @retval         0               OK
+ *  @retval         -1              FAIL
+ *  @since          October 18, 2026
+ */
+int fanout_read32(t_pciinfo_card *card, void *arg)
+{
+    const t_fanout_reg  *reg = (const t_fanout_reg*) arg;
+
+    if ( (NULL == card->bar[reg->bar]) || (0 != (reg->off & 0x3)) ||
+         ((reg->off + sizeof(uint32_t)) > card->barSize[reg->bar]) ) {
+        return -1;
+    }
+    card->result = *((volatile uint32_t*) ((uint8_t*) card->bar[reg->bar] + reg->off));
+    return 0;
+}
+
+
+
+/**
+ *  @brief print_pm
+ *
+ *  prints power management state
+ *
+ *  @param[in]      msgLevel        output message level
+ *  @param[in]      varPfx          bash variable prefix
+ *  @param[in]      idx             device index
+ *  @param[in]      pm              power management state
+ *  @return         none
+ *  @since          October 18, 2026
+ */
+void print_pm(int msgLevel, const char varPfx[], int idx, const t_pciinfo_pm *pm)
+{
+    char    charLink[64];
+
+    snprintf    (   charLink, sizeof(charLink), "L0s=%d L1=%d L1.1=%d L1.2=%d ClkPM=%d",
+                    pm->l0sAspm, pm->l1Aspm, pm->l11Aspm, pm->l12Aspm, pm->clkpm
+                );
+    if ( MSG_LEVEL_NORM <= msgLevel ) {
+        printf("             %s  runtime=%-10s control=%-5s %s", pm->bdf, pm->runtimeStatus, pm->control, charLink);
+        if ( 0 != pm->err ) {
+            printf("  FAIL: %s", strerror(pm->err));
+        }
+        printf("\n");
+    } else {
+        printf("%s_%d_BDF=\"%s\"\n", varPfx, idx, pm->bdf);
+        printf("%s_%d_RUNTIME=\"%s\"\n", varPfx, idx, pm->runtimeStatus);
+        printf("%s_%d_CONTROL=\"%s\"\n", varPfx, idx, pm->control);
+        printf("%s_%d_ASPM=\"%s\"\n", varPfx, idx, charLink);
+        printf("%s_%d_ERR=%d\n", varPfx, idx, pm->err);
+    }
+}
+
+
+
+/**
+ *  @brief print_tree
+ *
+ *  prints PCI topology below given node recursively
+ *
+ *  @param[in]      dev             device list
+ *  @param[in]      num             number of devices in list
+ *  @param[in]      parent          index of parent device, -1 for root complex
+ *  @param[in]      host            root complex
+ *  @param[in]      level           indentation level
+ *  @return         none
+ *  @since          October 18, 2026
+ */
+void print_tree(const t_pciinfo_dev dev[], int num, int32_t parent, const char host[], int level)
+{
+    for ( int i = 0; i < num; i++ ) {
+        if ( (parent != dev[i].parent) || (0 != strcmp(host, dev[i].host)) ) {
+            continue;
+        }
+        printf("             %*s+- %s [%04x:%04x]", 3*level, "", dev[i].bdf, dev[i].vendor, dev[i].device);
+        if ( NULL != pciinfoNameDevice(dev[i].vendor, dev[i].device) ) {
+            printf  (   " %s %s", (NULL != pciinfoNameVendor(dev[i].vendor)) ? pciinfoNameVendor(dev[i].vendor) : "",
+                        pciinfoNameDevice(dev[i].vendor, dev[i].device)
+                    );
+        }
+        printf("\n");
+        print_tree(dev, num, (int32_t) i, host, level + 1);
+    }
+}
+
+
+
 /**
  *  @brief main
  *
@@ -131,6 +369,31 @@ int main (int argc, char *argv[])
     int8_t      int8CliBarNum;      // CLI: select bar to output
     int8_t      int8CliSize;        // CLI: output bar size
     int8_t      int8CliSizeNum;     // CLI: select bar to output
+    int8_t      int8CliDevReq;      // CLI: job for device with VID/DID requested
+    int8_t      int8CliTree;        // CLI: output PCI topology
+    int8_t      int8CliDist;        // CLI: output distance to other device
+    int8_t      int8CliBind;        // CLI: list or change driver binding
+    int8_t      int8CliNames;       // CLI: output vendor/device names
+    int8_t      int8CliWatch;       // CLI: register watch
+    int8_t      int8CliWatchBar;    // CLI: register watch BAR
+    int8_t      int8CliDump;        // CLI: dump BAR into image
+    int8_t      int8CliRestore;     // CLI: restore image into BAR
+    int8_t      int8CliDiff;        // CLI: diff image
+    int8_t      int8CliXferBar;     // CLI: BAR of dump, restore, diff
+    int8_t      int8CliIrq;         // CLI: interrupt vectors
+    int8_t      int8CliIrqSpread;   // CLI: spread interrupt vectors
+    uint32_t    uint32IrqMs;        // CLI: interrupt rate interval
+    int8_t      int8CliAer;         // CLI: AER sampling
+    uint32_t    uint32AerMs;        // CLI: AER sample interval
+    uint64_t    uint64AerCount;     // CLI: AER samples, 0 until Ctrl-C
+    double      dblAerReplay;       // CLI: AER replay threshold
+    double      dblAerBadTlp;       // CLI: AER bad TLP threshold
+    int8_t      int8CliPm;          // CLI: power management, 1: list, 2: on, 3: restore
+    int8_t      int8CliFanout;      // CLI: fan-out register read
+    uint32_t    uint32FanoutThreads;    // CLI: fan-out worker threads
+    int8_t      int8CliDma;         // CLI: DMA buffer
+    uint64_t    uint64DmaSize;      // CLI: DMA buffer size
+    uint64_t    uint64DmaPage;      // CLI: DMA buffer page size
 
     uint8_t     uint8IterStart;     // help iterator two merge the 'all' programming path with 'dedicated' programming path
     uint8_t     uint8IterStop;      // help iterator two merge the 'all' programming path with 'dedicated' programming path
@@ -140,6 +403,40 @@ int main (int argc, char *argv[])
     int         intExistingBar;     // bit index belongs to bar number
     uint32_t    uint32BarPhyAdr;    // physical bar address
     uint32_t    uint32BarSize;      // bar size in byte
+    char        charDist[PCIINFO_PATH_MAX];     // other device for distance
+    char        charAncestor[PCIINFO_BDF_MAX];  // common bridge
+    int         intHops;            // hop distance
+    int         intDevNum;          // number of PCI devices
+    static t_pciinfo_dev    dev[DEF_SET_DEV_MAX];   // PCI device list
+    static t_pciinfo_bind   bind[DEF_SET_DEV_MAX];  // driver binding
+    t_pciinfo_match         match;                  // device filter for multi device operations
+    char        charDrv[PCIINFO_DRV_MAX];           // new driver
+    char        charVarPfx[32];                     // bash variable prefix of multi device operations
+    char        charNamesDb[PCIINFO_PATH_MAX];      // compiled pci.ids
+    const char  *charName;                          // name lookup result
+    char        charBarFile[PCIINFO_PATH_MAX];      // BAR resource file or stand-in
+    char        charTrace[PCIINFO_PATH_MAX];        // register watch trace file
+    char        *charTok;                           // register offset list parser
+    uint32_t    uint32WatchOff[DEF_SET_WATCH_REGS]; // watched register offsets
+    t_pciinfo_watch watch;                          // register watch
+    char        charImage[PCIINFO_PATH_MAX];        // BAR image
+    char        charRef[PCIINFO_PATH_MAX];          // reference BAR image
+    uint64_t    uint64XferOff;                      // BAR offset of dump, restore, diff
+    uint64_t    uint64XferLen;                      // length of dump
+    t_pciinfo_xfer  xfer;                           // BAR transfer statistic
+    int         intIrqNum;                          // number of interrupt vectors
+    uint32_t    uint32IrqCpus;                      // CPUs serving a vector
+    uint32_t    uint32IrqMax;                       // allocated interrupt vectors
+    t_pciinfo_irq   *irq;                           // interrupt vectors
+    t_pciinfo_irq   *irqPrev;                       // interrupt vectors at interval start
+    static t_pciinfo_aer_rate   aer[DEF_SET_DEV_MAX];   // AER rates
+    uint64_t    uint64AerSample;                    // AER sample counter
+    static t_pciinfo_pm pm[DEF_SET_DEV_MAX];        // power management state
+    char        charPmState[PCIINFO_PATH_MAX];      // saved power management state
+    static t_pciinfo_card   card[DEF_SET_DEV_MAX];  // fan-out devices
+    t_fanout_reg    fanoutReg;                      // fan-out register
+    uint64_t    uint64FanoutLen;                    // fan-out register range, only offset allowed
+    t_pciinfo_dma   dma;                            // DMA buffer
 
 
     /* command line parser */
@@ -160,11 +457,41 @@ int main (int argc, char *argv[])
         {"adr",         optional_argument,  0,  'a'},   // bar physical addresses
         {"size",        optional_argument,  0,  's'},   // bar sizes
         {"bus",         no_argument,        0,  'b'},   // PCI bus and function
+        {"tree",        no_argument,        0,  't'},   // PCI topology
+        {"dist",        required_argument,  0,  'D'},   // distance to other device
+        {"root",        required_argument,  0,  'R'},   // sysfs root
+        {"bdf",         required_argument,  0,  'F'},   // BDF filter
+        {"iommu",       no_argument,        0,  'I'},   // driver and IOMMU group
+        {"bind",        required_argument,  0,  'B'},   // driver binding
+        {"names",       optional_argument,  0,  'N'},   // vendor/device names
+        {"watch",       required_argument,  0,  'W'},   // register watch
+        {"rate",        required_argument,  0,  'r'},   // register watch rate
+        {"count",       required_argument,  0,  'c'},   // register watch samples
+        {"changes",     no_argument,        0,  'C'},   // register watch changes only
+        {"trace",       required_argument,  0,  'T'},   // register watch trace file
+        {"file",        required_argument,  0,  'f'},   // BAR stand-in
+        {"dump",        required_argument,  0,  'X'},   // BAR dump
+        {"restore",     required_argument,  0,  'Y'},   // BAR restore
+        {"diff",        required_argument,  0,  'Z'},   // BAR diff
+        {"image",       required_argument,  0,  'i'},   // BAR image
+        {"ref",         required_argument,  0,  'x'},   // reference BAR image
+        {"irq",         optional_argument,  0,  'q'},   // interrupt vectors
+        {"irq-spread",  no_argument,        0,  'Q'},   // spread interrupt vectors
+        {"proc",        required_argument,  0,  'P'},   // procfs root
+        {"aer",         optional_argument,  0,  'A'},   // AER sampling
+        {"aer-max",     required_argument,  0,  'M'},   // AER thresholds
+        {"aer-count",   required_argument,  0,  'K'},   // AER samples
+        {"pm",          no_argument,        0,  'o'},   // power management
+        {"pm-on",       required_argument,  0,  'O'},   // disable power saving
+        {"pm-restore",  required_argument,  0,  'S'},   // restore power management
+        {"fanout",      required_argument,  0,  'g'},   // parallel register read
+        {"threads",     required_argument,  0,  'j'},   // fan-out worker threads
+        {"dma",         required_argument,  0,  'm'},   // DMA buffer
         {"help",        no_argument,        0,  'h'},   // print help
         /* Protection */
         {0,             0,                  0,  0 }     // NULL
     };
-    static const char shortopt[] = "v:d:pea::s::bh";
+    static const char shortopt[] = "v:d:pea::s::bh";  // 'long only' options use the free characters as index
 
 
 
@@ -174,6 +501,45 @@ int main (int argc, char *argv[])
     int8CliBarExists = 0;   // BAR existence
     int8CliBar = 0;         // BAR: Physical address output disabled
     int8CliSize = 0;        // BAR: Size output disabled
+    int8CliDevReq = 0;      // no device job
+    int8CliTree = 0;        // topology output disabled
+    int8CliDist = 0;        // distance output disabled
+    int8CliBind = 0;        // driver binding disabled
+    int8CliNames = 0;       // raw ids only
+    strncpy(charNamesDb, PCIINFO_NAMES_DB, sizeof(charNamesDb));
+    int8CliWatch = 0;       // register watch disabled
+    int8CliWatchBar = 0;    // BAR0
+    charBarFile[0] = '\0';  // BAR of device
+    strncpy(charTrace, DEF_SET_TRACE, sizeof(charTrace));
+    memset(&watch, 0, sizeof(watch));
+    watch.rateHz = DEF_SET_WATCH_RATE;
+    watch.off = uint32WatchOff;
+    watch.stop = &g_stop;
+    int8CliDump = 0;        // BAR dump disabled
+    int8CliRestore = 0;     // BAR restore disabled
+    int8CliDiff = 0;        // BAR diff disabled
+    int8CliXferBar = 0;     // BAR0
+    uint64XferOff = 0;      // BAR start
+    uint64XferLen = 0;      // complete BAR
+    strncpy(charImage, DEF_SET_IMAGE, sizeof(charImage));
+    charRef[0] = '\0';      // diff against live BAR
+    int8CliIrq = 0;         // interrupt vectors disabled
+    int8CliIrqSpread = 0;   // keep affinity
+    uint32IrqMs = DEF_SET_IRQ_MS;
+    int8CliAer = 0;         // AER sampling disabled
+    uint32AerMs = DEF_SET_AER_MS;
+    uint64AerCount = 0;     // until Ctrl-C
+    dblAerReplay = DEF_SET_AER_REPLAY;
+    dblAerBadTlp = DEF_SET_AER_BADTLP;
+    int8CliPm = 0;          // power management disabled
+    charPmState[0] = '\0';  // no saved state
+    int8CliFanout = 0;      // fan-out disabled
+    uint32FanoutThreads = 0;    // library default
+    int8CliDma = 0;         // DMA buffer disabled
+    uint64DmaSize = 0;
+    uint64DmaPage = 0;      // library default
+    charDrv[0] = '\0';      // report driver only
+    memset(&match, 0, sizeof(match));   // match all devices
     strncpy(charVid, DEF_SET_VID, sizeof(charVid)); // default Vendor ID
     strncpy(charDid, DEF_SET_DID, sizeof(charDid)); // default Device ID
 
@@ -217,12 +583,14 @@ int main (int argc, char *argv[])
             case 'p':
                 int8CliPath = 1;    // output path
                 int8CliNoArg = 0;   // CLI used
+                int8CliDevReq = 1;  // device job
                 break;
 
             /* Argument: 'exist' - check if bar exists */
             case 'e':
                 int8CliBarExists = 1;   // BARs are existent output
                 int8CliNoArg = 0;       // CLI used
+                int8CliDevReq = 1;      // device job
                 break;
 
             /* Argument: 'adr' - physical bar address */
@@ -240,6 +608,7 @@ int main (int argc, char *argv[])
 
                 }
                 int8CliNoArg = 0;   // CLI used
+                int8CliDevReq = 1;  // device job
                 int8CliBar = 1;     // enable phy address bar output
                 break;
 
@@ -258,9 +627,279 @@ int main (int argc, char *argv[])
 
                 }
                 int8CliNoArg = 0;   // CLI used
+                int8CliDevReq = 1;  // device job
                 int8CliSize = 1;    // enable phy address bar output
                 break;
 
+            /* Argument: 'tree' - PCI topology */
+            case 't':
+                int8CliTree = 1;    // output topology
+                int8CliNoArg = 0;   // CLI used
+                break;
+
+            /* Argument: 'dist=<bdf>' - distance to other device */
+            case 'D':
+                if ( (strlen(optarg) + 1) > sizeof(charDist) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   not enough static memory\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                strncpy(charDist, optarg, sizeof(charDist));
+                int8CliDist = 1;    // output distance
+                int8CliNoArg = 0;   // CLI used
+                int8CliDevReq = 1;  // device job
+                break;
+
+            /* Argument: 'bdf=<prefix>' - restrict to BDF */
+            case 'F':
+                if ( (strlen(optarg) + 1) > sizeof(match.bdf) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   not enough static memory\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                strncpy(match.bdf, optarg, sizeof(match.bdf));
+                break;
+
+            /* Argument: 'iommu' - list driver and IOMMU group */
+            case 'I':
+                int8CliBind = 1;    // report binding
+                int8CliNoArg = 0;   // CLI used
+                break;
+
+            /* Argument: 'bind=<drv>' - bind to driver */
+            case 'B':
+                if ( (strlen(optarg) + 1) > sizeof(charDrv) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   not enough static memory\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                strncpy(charDrv, optarg, sizeof(charDrv));
+                int8CliBind = 1;    // change binding
+                int8CliNoArg = 0;   // CLI used
+                break;
+
+            /* Argument: 'names=<db>' - resolve vendor/device names */
+            case 'N':
+                if ( NULL != optarg ) {
+                    if ( (strlen(optarg) + 1) > sizeof(charNamesDb) ) {
+                        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                            printf("[ FAIL ]   not enough static memory\n");
+                        }
+                        goto ERO_END_L0;
+                    }
+                    strncpy(charNamesDb, optarg, sizeof(charNamesDb));
+                }
+                int8CliNames = 1;   // names output, modifies other outputs
+                break;
+
+            /* Argument: 'watch=<bar>:<off>[,<off>...]' - register watch */
+            case 'W':
+                charTok = strtok(optarg, ":");
+                if ( (NULL == charTok) || (0 > atoi(charTok)) || (5 < atoi(charTok)) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   PCI Bar number only between 0 and 5\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                int8CliWatchBar = (int8_t) atoi(charTok);
+                while ( NULL != (charTok = strtok(NULL, ",")) ) {
+                    if ( watch.offNum >= DEF_SET_WATCH_REGS ) {
+                        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                            printf("[ FAIL ]   not more than %d registers\n", DEF_SET_WATCH_REGS);
+                        }
+                        goto ERO_END_L0;
+                    }
+                    uint32WatchOff[watch.offNum++] = (uint32_t) strtoul(charTok, NULL, 0);
+                }
+                if ( 0 == watch.offNum ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   no register offset given\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                int8CliWatch = 1;   // watch registers
+                int8CliNoArg = 0;   // CLI used
+                break;
+
+            /* Argument: 'rate=<hz>' - register watch sample rate */
+            case 'r':
+                watch.rateHz = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+
+            /* Argument: 'count=<num>' - register watch samples */
+            case 'c':
+                watch.count = (uint64_t) strtoull(optarg, NULL, 0);
+                break;
+
+            /* Argument: 'changes' - log only changed values */
+            case 'C':
+                watch.onlyChange = 1;
+                break;
+
+            /* Argument: 'trace=<file>' - register watch trace file */
+            case 'T':
+                if ( (strlen(optarg) + 1) > sizeof(charTrace) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   not enough static memory\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                strncpy(charTrace, optarg, sizeof(charTrace));
+                break;
+
+            /* Argument: 'file=<path>' - BAR stand-in */
+            case 'f':
+                if ( (strlen(optarg) + 1) > sizeof(charBarFile) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   not enough static memory\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                strncpy(charBarFile, optarg, sizeof(charBarFile));
+                break;
+
+            /* Argument: 'dump|restore|diff=<bar>[:<off>[:<len>]]' - BAR image */
+            case 'X':
+            case 'Y':
+            case 'Z':
+                if ( 0 != parse_bar_range(optarg, &int8CliXferBar, &uint64XferOff, &uint64XferLen) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   '%s' is no <bar>[:<off>[:<len>]], PCI Bar number only between 0 and 5\n", optarg);
+                    }
+                    goto ERO_END_L0;
+                }
+                int8CliDump = (int8_t) (int8CliDump | ('X' == opt));
+                int8CliRestore = (int8_t) (int8CliRestore | ('Y' == opt));
+                int8CliDiff = (int8_t) (int8CliDiff | ('Z' == opt));
+                int8CliNoArg = 0;   // CLI used
+                break;
+
+            /* Argument: 'image=<file>' and 'ref=<file>' - BAR images */
+            case 'i':
+            case 'x':
+                if ( (strlen(optarg) + 1) > sizeof(charImage) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   not enough static memory\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                strncpy(('i' == opt) ? charImage : charRef, optarg, sizeof(charImage));
+                break;
+
+            /* Argument: 'irq=[<ms>]' - interrupt vectors */
+            case 'q':
+                if ( NULL != optarg ) {
+                    uint32IrqMs = (uint32_t) strtoul(optarg, NULL, 0);
+                }
+                int8CliIrq = 1;     // list vectors
+                int8CliNoArg = 0;   // CLI used
+                int8CliDevReq = 1;  // device job
+                break;
+
+            /* Argument: 'irq-spread' - spread interrupt vectors */
+            case 'Q':
+                int8CliIrqSpread = 1;   // apply affinity plan
+                int8CliIrq = 1;         // list vectors
+                int8CliNoArg = 0;       // CLI used
+                int8CliDevReq = 1;      // device job
+                break;
+
+            /* Argument: 'aer=[<ms>]' - AER sampling */
+            case 'A':
+                if ( NULL != optarg ) {
+                    uint32AerMs = (uint32_t) strtoul(optarg, NULL, 0);
+                }
+                int8CliAer = 1;     // sample AER
+                int8CliNoArg = 0;   // CLI used
+                break;
+
+            /* Argument: 'aer-max=<replay>[,<badtlp>]' - AER thresholds */
+            case 'M':
+                dblAerReplay = strtod(optarg, &charTok);
+                if ( ',' == *charTok ) {
+                    dblAerBadTlp = strtod(charTok + 1, NULL);
+                }
+                break;
+
+            /* Argument: 'aer-count=<num>' - AER samples */
+            case 'K':
+                uint64AerCount = (uint64_t) strtoull(optarg, NULL, 0);
+                break;
+
+            /* Argument: 'pm', 'pm-on=<state>', 'pm-restore=<state>' - power management */
+            case 'o':
+            case 'O':
+            case 'S':
+                if ( NULL != optarg ) {
+                    if ( (strlen(optarg) + 1) > sizeof(charPmState) ) {
+                        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                            printf("[ FAIL ]   not enough static memory\n");
+                        }
+                        goto ERO_END_L0;
+                    }
+                    strncpy(charPmState, optarg, sizeof(charPmState));
+                }
+                int8CliPm = ('o' == opt) ? 1 : ('O' == opt) ? 2 : 3;
+                int8CliNoArg = 0;   // CLI used
+                break;
+
+            /* Argument: 'fanout=<bar>:<off>' - parallel register read */
+            case 'g':
+                if ( (0 != parse_bar_range(optarg, &fanoutReg.bar, &fanoutReg.off, &uint64FanoutLen)) || (0 != uint64FanoutLen) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   '%s' is no <bar>:<off>, PCI Bar number only between 0 and 5\n", optarg);
+                    }
+                    goto ERO_END_L0;
+                }
+                int8CliFanout = 1;  // read register
+                int8CliNoArg = 0;   // CLI used
+                break;
+
+            /* Argument: 'threads=<num>' - fan-out worker threads */
+            case 'j':
+                uint32FanoutThreads = (uint32_t) strtoul(optarg, NULL, 0);
+                break;
+
+            /* Argument: 'dma=<size>[:<page>]' - DMA buffer */
+            case 'm':
+                uint64DmaSize = (uint64_t) strtoull(optarg, &charTok, 0);
+                if ( ':' == *charTok ) {
+                    uint64DmaPage = (uint64_t) strtoull(charTok + 1, &charTok, 0);
+                }
+                if ( (0 == uint64DmaSize) || ('\0' != *charTok) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   '%s' is no <size>[:<page>]\n", optarg);
+                    }
+                    goto ERO_END_L0;
+                }
+                int8CliDma = 1;     // allocate buffer
+                int8CliNoArg = 0;   // CLI used
+                int8CliDevReq = 1;  // device job
+                break;
+
+            /* Argument: 'proc=<dir>' - procfs root */
+            case 'P':
+                if ( 0 != pciinfoProcRoot(optarg) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   not enough static memory\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                break;
+
+            /* Argument: 'root=<dir>' - sysfs root */
+            case 'R':
+                if ( 0 != pciinfoSysRoot(optarg) ) {
+                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                        printf("[ FAIL ]   not enough static memory\n");
+                    }
+                    goto ERO_END_L0;
+                }
+                break;
+
 
 
 
@@ -288,6 +927,16 @@ int main (int argc, char *argv[])
         printf("[ INFO ]   PCIINFO started\n");
     }
 
+    /* open name database */
+    if ( 0 != int8CliNames ) {
+        if ( 0 != pciinfoNamesOpen(charNamesDb) ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   PCI id database '%s' not opened, build with 'make names'\n", charNamesDb);
+            }
+            goto ERO_END_L0;
+        }
+    }
+
     /* CLI called, otherwise output all info */
     if ( 0 != int8CliNoArg ) {
         int8CliPath = 1;        // output path to device
@@ -296,143 +945,609 @@ int main (int argc, char *argv[])
         int8CliSize = 1;        // enable size output
         int8CliSizeNum = -1;    // output all availabe sizes
         int8CliBarExists = 1;   // output bar existence
+        int8CliDevReq = 1;      // device job
     }
 
-    /* find path based on VID/DID */
-    charPath[0] = '\0';
-    if ( 0 != pciinfoFind(charVid, charDid, charPath, sizeof(charPath)) ) {
-        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-            printf("[ FAIL ]   PCI device with VID=%s/DID=%s not found\n", charVid, charDid);
+    /* PCI topology, '--tree' */
+    if ( 0 != int8CliTree ) {
+        intDevNum = pciinfoTopo(dev, DEF_SET_DEV_MAX);
+        if ( 0 > intDevNum ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   PCI topology not acquired\n");
+            }
+            goto ERO_END_L0;
         }
-        goto ERO_END_L0;
-    }
-    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-        printf("[ OKAY ]   FOUND PCI device with VID=%s/DID=%s\n", charVid, charDid);
-    }
-
-    /* prepare for bash variable output */
-    touppers(charVid);  // convert to uper case
-    touppers(charDid);
-
-    /* PCI Device Path */
-    if ( 0 != int8CliPath ) {
         if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-            printf("[ INFO ]   PCI Device File Handle\n");
-            printf("             %s\n", charPath);
+            printf("[ INFO ]   PCI topology:\n");
+            for ( int i = 0; i < intDevNum; i++ ) {
+                /* print each root complex once */
+                int j;
+                for ( j = 0; j < i; j++ ) {
+                    if ( 0 == strcmp(dev[i].host, dev[j].host) ) {
+                        break;
+                    }
+                }
+                if ( j == i ) {
+                    printf("             %s\n", dev[i].host);
+                    print_tree(dev, intDevNum, -1, dev[i].host, 0);
+                }
+            }
         } else {
-            printf("PCIINFO_%s_%s_PATH=\"%s\"\n", charVid+2, charDid+2, charPath);
+            for ( int i = 0; i < intDevNum; i++ ) {
+                printf  (   "PCIINFO_TREE_%d=\"%s %s %d\"\n", i, dev[i].bdf,
+                            (0 > dev[i].parent) ? dev[i].host : dev[dev[i].parent].bdf, dev[i].depth
+                        );
+            }
         }
     }
 
-    /* BAR existences */
-    intExistingBar = pciinfoBarExist(charPath); // discover bars
-    if ( 0 != int8CliBarExists ) {
+    /* device filter and bash variable prefix for multi device operations */
+    strncpy(match.vendorID, charVid, sizeof(match.vendorID));
+    strncpy(match.deviceID, charDid, sizeof(match.deviceID));
+    snprintf    (   charVarPfx, sizeof(charVarPfx), "PCIINFO_%s_%s",
+                    ('\0' == charVid[0]) ? "ALL" : (0 == strncasecmp(charVid, "0x", 2)) ? charVid+2 : charVid,
+                    ('\0' == charDid[0]) ? "ALL" : (0 == strncasecmp(charDid, "0x", 2)) ? charDid+2 : charDid
+                );
+    touppers(charVarPfx);
+
+    /* Driver binding, '--iommu' | '--bind=<drv>' */
+    if ( 0 != int8CliBind ) {
+        intDevNum = pciinfoBind(&match, charDrv, bind, DEF_SET_DEV_MAX);
+        if ( 0 > intDevNum ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   Driver binding not acquired\n");
+            }
+            goto ERO_END_L0;
+        }
         if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-            if ( 0 == intExistingBar ) {
-                printf("[ WARN ]   No PCI BARs found\n");
+            if ( '\0' == charDrv[0] ) {
+                printf("[ INFO ]   Driver and IOMMU group:\n");
             } else {
-                printf("[ INFO ]   Available PCI BARs:\n");
-                printf("             ");
-                for ( uint8_t i = 0; i < 6; i++ ) {
-                    if ( 0 != (intExistingBar & (1<<i)) ) {
-                        printf("BAR%d ", i);
-                    }
+                printf("[ INFO ]   Bind to driver '%s':\n", charDrv);
+            }
+        }
+        for ( int i = 0; i < intDevNum; i++ ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf  (   "             %s  iommu=%-4d %s -> %s",
+                            bind[i].bdf, bind[i].iommuGroup,
+                            ('\0' == bind[i].drvOld[0]) ? "none" : bind[i].drvOld,
+                            ('\0' == bind[i].drvNew[0]) ? "none" : bind[i].drvNew
+                        );
+                if ( '\0' != charDrv[0] ) {
+                    printf  (   "  unbind=%luus override=%luus bind=%luus",
+                                (unsigned long) (bind[i].nsUnbind / 1000),
+                                (unsigned long) (bind[i].nsOverride / 1000),
+                                (unsigned long) (bind[i].nsBind / 1000)
+                            );
+                }
+                if ( NULL != bind[i].errStep ) {
+                    printf("  FAIL:%s: %s", bind[i].errStep, strerror(bind[i].err));
                 }
                 printf("\n");
+            } else {
+                printf("%s_%d_BDF=\"%s\"\n", charVarPfx, i, bind[i].bdf);
+                printf("%s_%d_DRV=\"%s\"\n", charVarPfx, i, bind[i].drvNew);
+                printf("%s_%d_IOMMU=%d\n", charVarPfx, i, bind[i].iommuGroup);
+                printf("%s_%d_ERR=%d\n", charVarPfx, i, bind[i].err);
+            }
+        }
+        /* some function failed */
+        for ( int i = 0; i < intDevNum; i++ ) {
+            if ( NULL != bind[i].errStep ) {
+                goto ERO_END_L0;
+            }
+        }
+    }
+
+    /* Power management, '--pm' | '--pm-on=<state>' | '--pm-restore=<state>' */
+    if ( 3 == int8CliPm ) {
+        intDevNum = pciinfoPmRestore(charPmState);
+        if ( 0 > intDevNum ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   Power management not restored from '%s'\n", charPmState);
             }
+            goto ERO_END_L0;
+        }
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("[ INFO ]   Power management of %d functions restored from '%s'\n", intDevNum, charPmState);
+        }
+    } else if ( 0 != int8CliPm ) {
+        if ( 2 == int8CliPm ) {
+            intDevNum = pciinfoPmOn(&match, charPmState, pm, DEF_SET_DEV_MAX);
         } else {
-            for ( uint8_t i = 0; i < 6; i++ ) {
-                if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
-                    if ( 0 != (intExistingBar & (1<<i)) ) {
-                        printf("PCIINFO_%s_%s_BAR_%d_EXISTS=y\n", charVid+2, charDid+2, i);
-                    } else {
-                        printf("PCIINFO_%s_%s_BAR_%d_EXISTS=n\n", charVid+2, charDid+2, i);
-                    }
+            intDevNum = pciinfoMatch(&match, dev, DEF_SET_DEV_MAX);
+            for ( int i = 0; i < intDevNum; i++ ) {
+                if ( 0 != pciinfoPmGet(dev[i].path, &pm[i]) ) {
+                    intDevNum = -1;
                 }
             }
         }
+        if ( 0 > intDevNum ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                if ( 2 == int8CliPm ) {
+                    printf("[ FAIL ]   Power management not switched, state '%s' exists or is not writeable\n", charPmState);
+                } else {
+                    printf("[ FAIL ]   Power management not acquired\n");
+                }
+            }
+            goto ERO_END_L0;
+        }
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("[ INFO ]   Power management%s:\n", (2 == int8CliPm) ? " switched on" : "");
+        }
+        for ( int i = 0; i < intDevNum; i++ ) {
+            print_pm(intMsgLevel, charVarPfx, i, &pm[i]);
+        }
+        for ( int i = 0; i < intDevNum; i++ ) {
+            if ( 0 != pm[i].err ) {
+                goto ERO_END_L0;
+            }
+        }
     }
 
-    /* BAR physical addresses, '-a' | '--adr=<barNum>' */
-    if ( 0 != int8CliBar ) {
-        /* 'all' or 'dedicated' BAR */
-        if ( -1 == int8CliBarNum ) {
-            uint8IterStart = 0;
-            uint8IterStop = 6;
-        } else {
-            uint8IterStart = (uint8_t) int8CliBarNum;
-            uint8IterStop = (uint8_t) (int8CliBarNum + 1);
+    /* Fan-out register read, '--fanout=<bar>:<off>' */
+    if ( 0 != int8CliFanout ) {
+        intDevNum = pciinfoFanout(&match, (uint8_t) (1 << fanoutReg.bar), 0, uint32FanoutThreads, fanout_read32, &fanoutReg, card, DEF_SET_DEV_MAX);
+        if ( 0 > intDevNum ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   Fan-out failed\n");
+            }
+            goto ERO_END_L0;
         }
-        /* entry message */
         if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-            printf("[ INFO ]   Physical BAR adress:\n");
+            printf("[ INFO ]   BAR%d[0x%lx] of %d devices:\n", fanoutReg.bar, (unsigned long) fanoutReg.off, intDevNum);
         }
-        /* print bars */
-        for ( uint8_t i = uint8IterStart; i < uint8IterStop; i++ ) {
-            if ( 0 != (intExistingBar & (1<<i)) ) {
-                /* OK: get adr */
-                if ( 0 == pciinfoBarPhyAdr(charPath, i, &uint32BarPhyAdr) ) {
-                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-                        printf("             BAR%d = 0x%x\n", i, uint32BarPhyAdr);
-                    } else if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
-                        printf("PCIINFO_%s_%s_BAR_%d_ADR=0x%x\n", charVid+2, charDid+2, i, uint32BarPhyAdr);
-                    }
-                /* FAIL: get adr */
+        for ( int i = 0; i < intDevNum; i++ ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                if ( 0 != card[i].err ) {
+                    printf("             %s  FAIL: BAR%d not mapped, %s\n", card[i].dev.bdf, fanoutReg.bar, strerror(card[i].err));
+                } else if ( 0 == card[i].ret ) {
+                    printf("             %s  0x%08lx  %.3f ms\n", card[i].dev.bdf, (unsigned long) card[i].result, (double) card[i].ns / 1e6);
                 } else {
-                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-                        printf("             BAR%d = NaN\n", i);
-                    } else if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
-                        printf("PCIINFO_%s_%s_BAR_%d_ADR=NaN\n", charVid+2, charDid+2, i);
-                    }
+                    printf("             %s  FAIL: register not accessible\n", card[i].dev.bdf);
                 }
+            } else {
+                printf("%s_%d_BDF=\"%s\"\n", charVarPfx, i, card[i].dev.bdf);
+                printf("%s_%d_REG=0x%08lx\n", charVarPfx, i, (unsigned long) card[i].result);
+                printf("%s_%d_ERR=%d\n", charVarPfx, i, (0 != card[i].err) ? -card[i].err : card[i].ret);
+            }
+        }
+        for ( int i = 0; i < intDevNum; i++ ) {
+            if ( 0 != card[i].ret ) {
+                goto ERO_END_L0;
             }
         }
     }
 
-    /* BAR physical sizes, '-s' | '--size=<barNum>' */
-    if ( 0 != int8CliSize ) {
-        /* 'all' or 'dedicated' BAR */
-        if ( -1 == int8CliSizeNum ) {
-            uint8IterStart = 0;
-            uint8IterStop = 6;
-        } else {
-            uint8IterStart = (uint8_t) int8CliBarNum;
-            uint8IterStop = (uint8_t) (int8CliBarNum + 1);
+    /* AER sampling, '--aer=[<ms>]' */
+    if ( 0 != int8CliAer ) {
+        signal(SIGINT, sigint);
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("[ INFO ]   AER rates over %u ms, stop with Ctrl-C\n", uint32AerMs);
+        }
+        intDevNum = 0;  // first window
+        for ( uint64AerSample = 0; (0 == uint64AerCount) || (uint64AerSample < uint64AerCount); uint64AerSample++ ) {
+            intDevNum = pciinfoAerSample(&match, uint32AerMs, dblAerReplay, dblAerBadTlp, aer, (uint32_t) intDevNum, DEF_SET_DEV_MAX);
+            if ( 0 != g_stop ) {
+                break;
+            }
+            if ( 0 > intDevNum ) {
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("[ FAIL ]   AER counters not acquired\n");
+                }
+                goto ERO_END_L0;
+            }
+            /* one line per device for metrics scraper */
+            for ( int i = 0; i < intDevNum; i++ ) {
+                printf  (   "aer ts=%ld bdf=%s cor=%lu nonfatal=%lu fatal=%lu cor_ps=%.2f nonfatal_ps=%.2f fatal_ps=%.2f replay_ps=%.2f badtlp_ps=%.2f alarm=%d reset=%d\n",
+                            (long) time(NULL), aer[i].bdf, (unsigned long) aer[i].aer.corTotal,
+                            (unsigned long) aer[i].aer.nonfatalTotal, (unsigned long) aer[i].aer.fatalTotal,
+                            aer[i].corPs, aer[i].nonfatalPs, aer[i].fatalPs, aer[i].replayPs, aer[i].badTlpPs, aer[i].alarm, aer[i].reset
+                        );
+            }
+            fflush(stdout);
+        }
+    }
+
+    /* BAR operations on stand-in or reference image need no device */
+    if ( ((0 != int8CliWatch) && ('\0' == charBarFile[0])) ||
+         (0 != int8CliDump) || (0 != int8CliRestore) || ((0 != int8CliDiff) && ('\0' == charRef[0])) ) {
+        int8CliDevReq = 1;
+    }
+
+    /* job for a dedicated device */
+    charPath[0] = '\0';
+    if ( 0 != int8CliDevReq ) {
+        /* find path based on VID/DID */
+        if ( 0 != pciinfoFind(charVid, charDid, charPath, sizeof(charPath)) ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   PCI device with VID=%s/DID=%s not found\n", charVid, charDid);
+            }
+            goto ERO_END_L0;
         }
-        /* entry message */
         if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-            printf("[ INFO ]   BAR size in byte:\n");
+            printf("[ OKAY ]   FOUND PCI device with VID=%s/DID=%s\n", charVid, charDid);
         }
-        /* print bars */
-        for ( uint8_t i = uint8IterStart; i < uint8IterStop; i++ ) {
-            if ( 0 != (intExistingBar & (1<<i)) ) {
-                /* OK: get adr */
-                if ( 0 == pciinfoBarSize(charPath, i, &uint32BarSize) ) {
-                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-                        printf("             BAR%d = %d\n", i, uint32BarSize);
-                    } else if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
-                        printf("PCIINFO_%s_%s_BAR_%d_SIZE=%d\n", charVid+2, charDid+2, i, uint32BarSize);
+
+        /* prepare for bash variable output */
+        touppers(charVid);  // convert to uper case
+        touppers(charDid);
+
+        /* PCI Device Path */
+        if ( 0 != int8CliPath ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ INFO ]   PCI Device File Handle\n");
+                printf("             %s\n", charPath);
+            } else {
+                printf("PCIINFO_%s_%s_PATH=\"%s\"\n", charVid+2, charDid+2, charPath);
+            }
+        }
+
+        /* PCI Device Names, '--names' */
+        if ( 0 != int8CliNames ) {
+            strncpy(match.bdf, strrchr(charPath, '/') + 1, sizeof(match.bdf) - 1);
+            if ( 1 != pciinfoMatch(&match, dev, DEF_SET_DEV_MAX) ) {
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("[ FAIL ]   PCI device '%s' not enumerated\n", charPath);
+                }
+                goto ERO_END_L0;
+            }
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ INFO ]   PCI Device Name\n");
+            }
+            for ( uint8_t i = 0; i < 3; i++ ) {
+                const char  *charKind[] = {"VENDOR", "DEVICE", "SUBSYS"};
+                if ( 0 == i ) {
+                    charName = pciinfoNameVendor(dev[0].vendor);
+                } else if ( 1 == i ) {
+                    charName = pciinfoNameDevice(dev[0].vendor, dev[0].device);
+                } else {
+                    charName = pciinfoNameSubsys(dev[0].vendor, dev[0].device, dev[0].subVendor, dev[0].subDevice);
+                }
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("             %s = %s\n", charKind[i], (NULL == charName) ? "NaN" : charName);
+                } else {
+                    printf("PCIINFO_%s_%s_%s=\"%s\"\n", charVid+2, charDid+2, charKind[i], (NULL == charName) ? "" : charName);
+                }
+            }
+        }
+
+        /* Distance to other device, '--dist=<bdf>' */
+        if ( 0 != int8CliDist ) {
+            intHops = pciinfoDistance(charPath, charDist, charAncestor, sizeof(charAncestor));
+            if ( 0 > intHops ) {
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("[ FAIL ]   Distance to '%s' not acquired\n", charDist);
+                }
+                goto ERO_END_L0;
+            }
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ INFO ]   Distance to %s\n", charDist);
+                printf("             %d hops via %s\n", intHops, ('\0' == charAncestor[0]) ? "host" : charAncestor);
+            } else {
+                printf("PCIINFO_%s_%s_DIST=%d\n", charVid+2, charDid+2, intHops);
+                printf("PCIINFO_%s_%s_ANCESTOR=\"%s\"\n", charVid+2, charDid+2, charAncestor);
+            }
+        }
+
+        /* DMA buffer, '--dma=<size>[:<page>]' */
+        if ( 0 != int8CliDma ) {
+            if ( 0 != pciinfoDmaAlloc(charPath, (size_t) uint64DmaSize, (size_t) uint64DmaPage, &dma) ) {
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("[ FAIL ]   DMA buffer not allocated, check hugepages, NUMA binding and privileges\n");
+                }
+                goto ERO_END_L0;
+            }
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf  (   "[ INFO ]   DMA buffer 0x%lx byte, 0x%lx byte pages, node %d, %s:\n", (unsigned long) dma.size,
+                            (unsigned long) dma.pageSize, dma.node, (0 != pciinfoDmaContig(&dma)) ? "contiguous" : "scattered"
+                        );
+            } else {
+                printf("PCIINFO_%s_%s_DMA_SIZE=0x%lx\n", charVid+2, charDid+2, (unsigned long) dma.size);
+                printf("PCIINFO_%s_%s_DMA_NODE=%d\n", charVid+2, charDid+2, dma.node);
+                printf("PCIINFO_%s_%s_DMA_CONTIG=%d\n", charVid+2, charDid+2, pciinfoDmaContig(&dma));
+            }
+            for ( uint32_t i = 0; i < dma.segNum; i++ ) {
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf  (   "             +0x%-10lx phy = 0x%016lx  size = 0x%lx\n", (unsigned long) dma.seg[i].virtOff,
+                                (unsigned long) dma.seg[i].phyAdr, (unsigned long) dma.seg[i].size
+                            );
+                } else {
+                    printf("PCIINFO_%s_%s_DMA_%u_PHY=0x%lx\n", charVid+2, charDid+2, i, (unsigned long) dma.seg[i].phyAdr);
+                    printf("PCIINFO_%s_%s_DMA_%u_SIZE=0x%lx\n", charVid+2, charDid+2, i, (unsigned long) dma.seg[i].size);
+                }
+            }
+            pciinfoDmaFree(&dma);
+        }
+
+        /* Interrupt vectors, '--irq=[<ms>]' | '--irq-spread' */
+        if ( 0 != int8CliIrq ) {
+            /* vector arrays sized by device */
+            intIrqNum = pciinfoIrqList(charPath, NULL, 0);
+            irq = calloc((0 >= intIrqNum) ? 1 : (size_t) intIrqNum, sizeof(*irq));
+            irqPrev = calloc((0 >= intIrqNum) ? 1 : (size_t) intIrqNum, sizeof(*irqPrev));
+            if ( (0 > intIrqNum) || (NULL == irq) || (NULL == irqPrev) ) {
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("[ FAIL ]   Interrupt vectors not acquired\n");
+                }
+                free(irq);
+                free(irqPrev);
+                goto ERO_END_L0;
+            }
+            uint32IrqMax = (uint32_t) intIrqNum;
+            if ( 0 != int8CliIrqSpread ) {
+                intIrqNum = pciinfoIrqSpread(charPath, irqPrev, uint32IrqMax);
+            } else {
+                intIrqNum = pciinfoIrqList(charPath, irqPrev, uint32IrqMax);
+            }
+            /* rate over interval */
+            if ( (0 <= intIrqNum) && (0 != uint32IrqMs) ) {
+                pciinfoSleepMs(uint32IrqMs, &g_stop);
+            }
+            if ( (0 > intIrqNum) || (intIrqNum != pciinfoIrqList(charPath, irq, uint32IrqMax)) ) {
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("[ FAIL ]   Interrupt vectors not acquired or changed during interval\n");
+                }
+                pciinfoIrqFree(irq, uint32IrqMax);
+                pciinfoIrqFree(irqPrev, uint32IrqMax);
+                free(irq);
+                free(irqPrev);
+                goto ERO_END_L0;
+            }
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ INFO ]   Interrupt vectors, rate over %u ms:\n", uint32IrqMs);
+            }
+            for ( int i = 0; i < intIrqNum; i++ ) {
+                double  dblRate = (0 == uint32IrqMs) ? 0.0 : (double) (irq[i].count - irqPrev[i].count) * 1000.0 / uint32IrqMs;
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf  (   "             IRQ%-5u count = %-12lu rate = %10.1f/s  cpus = %s\n",
+                                irq[i].irq, (unsigned long) irq[i].count, dblRate, irq[i].affinity
+                            );
+                } else {
+                    printf("PCIINFO_%s_%s_IRQ_%d=%u\n", charVid+2, charDid+2, i, irq[i].irq);
+                    printf("PCIINFO_%s_%s_IRQ_%d_RATE=%.1f\n", charVid+2, charDid+2, i, dblRate);
+                    printf("PCIINFO_%s_%s_IRQ_%d_CPUS=\"%s\"\n", charVid+2, charDid+2, i, irq[i].affinity);
+                }
+                /* per CPU, only CPUs which served the vector */
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("                      per CPU:");
+                    uint32IrqCpus = 0;
+                    for ( uint32_t cpu = 0; (cpu < irq[i].cpuNum) && (cpu < irqPrev[i].cpuNum); cpu++ ) {
+                        if ( 0 == irq[i].cpuCount[cpu] ) {
+                            continue;
+                        }
+                        dblRate = (0 == uint32IrqMs) ? 0.0 : (double) (irq[i].cpuCount[cpu] - irqPrev[i].cpuCount[cpu]) * 1000.0 / uint32IrqMs;
+                        printf(" CPU%u=%lu (%.1f/s)", cpu, (unsigned long) irq[i].cpuCount[cpu], dblRate);
+                        ++uint32IrqCpus;
                     }
-                /* FAIL: get adr */
+                    printf("%s\n", (0 == uint32IrqCpus) ? " none" : "");
                 } else {
-                    if ( MSG_LEVEL_NORM <= intMsgLevel ) {
-                        printf("             BAR%d = NaN\n", i);
-                    } else if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
-                        printf("PCIINFO_%s_%s_BAR_%d_SIZE=NaN\n", charVid+2, charDid+2, i);
+                    printf("PCIINFO_%s_%s_IRQ_%d_CPU_COUNT=\"", charVid+2, charDid+2, i);
+                    uint32IrqCpus = 0;
+                    for ( uint32_t cpu = 0; cpu < irq[i].cpuNum; cpu++ ) {
+                        if ( 0 != irq[i].cpuCount[cpu] ) {
+                            printf("%s%u:%lu", (0 == uint32IrqCpus++) ? "" : " ", cpu, (unsigned long) irq[i].cpuCount[cpu]);
+                        }
+                    }
+                    printf("\"\nPCIINFO_%s_%s_IRQ_%d_CPU_RATE=\"", charVid+2, charDid+2, i);
+                    uint32IrqCpus = 0;
+                    for ( uint32_t cpu = 0; (cpu < irq[i].cpuNum) && (cpu < irqPrev[i].cpuNum); cpu++ ) {
+                        if ( irq[i].cpuCount[cpu] != irqPrev[i].cpuCount[cpu] ) {
+                            dblRate = (0 == uint32IrqMs) ? 0.0 : (double) (irq[i].cpuCount[cpu] - irqPrev[i].cpuCount[cpu]) * 1000.0 / uint32IrqMs;
+                            printf("%s%u:%.1f", (0 == uint32IrqCpus++) ? "" : " ", cpu, dblRate);
+                        }
+                    }
+                    printf("\"\n");
+                }
+            }
+            pciinfoIrqFree(irq, uint32IrqMax);
+            pciinfoIrqFree(irqPrev, uint32IrqMax);
+            free(irq);
+            free(irqPrev);
+        }
+
+        /* BAR existences */
+        intExistingBar = pciinfoBarExist(charPath); // discover bars
+        if ( 0 != int8CliBarExists ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                if ( 0 == intExistingBar ) {
+                    printf("[ WARN ]   No PCI BARs found\n");
+                } else {
+                    printf("[ INFO ]   Available PCI BARs:\n");
+                    printf("             ");
+                    for ( uint8_t i = 0; i < 6; i++ ) {
+                        if ( 0 != (intExistingBar & (1<<i)) ) {
+                            printf("BAR%d ", i);
+                        }
+                    }
+                    printf("\n");
+                }
+            } else {
+                for ( uint8_t i = 0; i < 6; i++ ) {
+                    if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
+                        if ( 0 != (intExistingBar & (1<<i)) ) {
+                            printf("PCIINFO_%s_%s_BAR_%d_EXISTS=y\n", charVid+2, charDid+2, i);
+                        } else {
+                            printf("PCIINFO_%s_%s_BAR_%d_EXISTS=n\n", charVid+2, charDid+2, i);
+                        }
+                    }
+                }
+            }
+        }
+
+        /* BAR physical addresses, '-a' | '--adr=<barNum>' */
+        if ( 0 != int8CliBar ) {
+            /* 'all' or 'dedicated' BAR */
+            if ( -1 == int8CliBarNum ) {
+                uint8IterStart = 0;
+                uint8IterStop = 6;
+            } else {
+                uint8IterStart = (uint8_t) int8CliBarNum;
+                uint8IterStop = (uint8_t) (int8CliBarNum + 1);
+            }
+            /* entry message */
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ INFO ]   Physical BAR adress:\n");
+            }
+            /* print bars */
+            for ( uint8_t i = uint8IterStart; i < uint8IterStop; i++ ) {
+                if ( 0 != (intExistingBar & (1<<i)) ) {
+                    /* OK: get adr */
+                    if ( 0 == pciinfoBarPhyAdr(charPath, i, &uint32BarPhyAdr) ) {
+                        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                            printf("             BAR%d = 0x%x\n", i, uint32BarPhyAdr);
+                        } else if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
+                            printf("PCIINFO_%s_%s_BAR_%d_ADR=0x%x\n", charVid+2, charDid+2, i, uint32BarPhyAdr);
+                        }
+                    /* FAIL: get adr */
+                    } else {
+                        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                            printf("             BAR%d = NaN\n", i);
+                        } else if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
+                            printf("PCIINFO_%s_%s_BAR_%d_ADR=NaN\n", charVid+2, charDid+2, i);
+                        }
                     }
                 }
             }
         }
+
+        /* BAR physical sizes, '-s' | '--size=<barNum>' */
+        if ( 0 != int8CliSize ) {
+            /* 'all' or 'dedicated' BAR */
+            if ( -1 == int8CliSizeNum ) {
+                uint8IterStart = 0;
+                uint8IterStop = 6;
+            } else {
+                uint8IterStart = (uint8_t) int8CliBarNum;
+                uint8IterStop = (uint8_t) (int8CliBarNum + 1);
+            }
+            /* entry message */
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ INFO ]   BAR size in byte:\n");
+            }
+            /* print bars */
+            for ( uint8_t i = uint8IterStart; i < uint8IterStop; i++ ) {
+                if ( 0 != (intExistingBar & (1<<i)) ) {
+                    /* OK: get adr */
+                    if ( 0 == pciinfoBarSize(charPath, i, &uint32BarSize) ) {
+                        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                            printf("             BAR%d = %d\n", i, uint32BarSize);
+                        } else if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
+                            printf("PCIINFO_%s_%s_BAR_%d_SIZE=%d\n", charVid+2, charDid+2, i, uint32BarSize);
+                        }
+                    /* FAIL: get adr */
+                    } else {
+                        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                            printf("             BAR%d = NaN\n", i);
+                        } else if ( MSG_LEVEL_BRIEF <= intMsgLevel ) {
+                            printf("PCIINFO_%s_%s_BAR_%d_SIZE=NaN\n", charVid+2, charDid+2, i);
+                        }
+                    }
+                }
+            }
+        }
+
+
+
+
+
+
+        /* BAR of device */
+        if ( ('\0' == charBarFile[0]) && ('\0' != charPath[0]) ) {
+            if ( sizeof(charBarFile) <= (size_t) snprintf(charBarFile, sizeof(charBarFile), "%s/resource%d", charPath, int8CliWatchBar) ) {
+                if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                    printf("[ FAIL ]   not enough static memory\n");
+                }
+                goto ERO_END_L0;
+            }
+        }
     }
 
 
 
+    /* Register watch, '--watch=<bar>:<off>[,<off>...]' */
+    if ( 0 != int8CliWatch ) {
+        watch.barFile = charBarFile;
+        watch.traceFile = charTrace;
+        signal(SIGINT, sigint);
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("[ INFO ]   Watch %u registers of '%s' with %u Hz, stop with Ctrl-C\n", watch.offNum, charBarFile, watch.rateHz);
+        }
+        if ( 0 != pciinfoWatch(&watch) ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   Register watch of '%s'\n", charBarFile);
+            }
+            goto ERO_END_L0;
+        }
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("[ INFO ]   Register watch trace '%s'\n", charTrace);
+            printf("             sampled = %lu\n", (unsigned long) watch.sampled);
+            printf("             logged  = %lu\n", (unsigned long) watch.logged);
+            printf("             dropped = %lu\n", (unsigned long) watch.dropped);
+            printf  (   "             rate    = %.0f Hz\n",
+                        (0 == watch.ns) ? 0.0 : (double) watch.sampled * 1e9 / (double) watch.ns
+                    );
+        } else {
+            printf("PCIINFO_WATCH_SAMPLED=%lu\n", (unsigned long) watch.sampled);
+            printf("PCIINFO_WATCH_LOGGED=%lu\n", (unsigned long) watch.logged);
+            printf("PCIINFO_WATCH_DROPPED=%lu\n", (unsigned long) watch.dropped);
+        }
+    }
 
+    /* BAR dump, '--dump=<bar>[:<off>[:<len>]]' */
+    if ( 0 != int8CliDump ) {
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("[ INFO ]   Dump BAR%d into '%s'\n", int8CliXferBar, charImage);
+        }
+        if ( 0 != pciinfoBarDump(charPath, (uint8_t) int8CliXferBar, uint64XferOff, uint64XferLen, charImage, &xfer) ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   BAR%d dump, check range and alignment\n", int8CliXferBar);
+            }
+            goto ERO_END_L0;
+        }
+        print_xfer(intMsgLevel, "DUMP", &xfer);
+    }
 
+    /* BAR restore, '--restore=<bar>[:<off>]' */
+    if ( 0 != int8CliRestore ) {
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("[ INFO ]   Restore '%s' into BAR%d\n", charImage, int8CliXferBar);
+        }
+        if ( 0 != pciinfoBarRestore(charPath, (uint8_t) int8CliXferBar, uint64XferOff, charImage, &xfer) ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   BAR%d restore, check range and alignment\n", int8CliXferBar);
+            }
+            goto ERO_END_L0;
+        }
+        print_xfer(intMsgLevel, "RESTORE", &xfer);
+    }
+
+    /* BAR diff, '--diff=<bar>[:<off>]' */
+    if ( 0 != int8CliDiff ) {
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("[ INFO ]   Diff '%s' against %s\n", charImage, ('\0' == charRef[0]) ? "live BAR" : charRef);
+        }
+        if ( 0 > pciinfoBarDiff (   charPath, (uint8_t) int8CliXferBar, uint64XferOff, charImage,
+                                    ('\0' == charRef[0]) ? NULL : charRef,
+                                    (MSG_LEVEL_NORM <= intMsgLevel) ? stdout : NULL, &xfer
+                                ) ) {
+            if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+                printf("[ FAIL ]   BAR%d diff, check range and alignment\n", int8CliXferBar);
+            }
+            goto ERO_END_L0;
+        }
+        if ( MSG_LEVEL_NORM <= intMsgLevel ) {
+            printf("             %lu changed lines\n", (unsigned long) xfer.lines);
+        } else {
+            printf("PCIINFO_DIFF_LINES=%lu\n", (unsigned long) xfer.lines);
+        }
+        print_xfer(intMsgLevel, "DIFF", &xfer);
+    }
 
     /* gracefull end */
     goto GD_END_L0; // avoid compile warning
     GD_END_L0:
+        pciinfoNamesClose();
         if ( MSG_LEVEL_NORM <= intMsgLevel ) {
             printf("[ OKAY ]   ended normally\n");
         }
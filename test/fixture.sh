@@ -0,0 +1,85 @@
+#!/bin/sh
+# ***********************************************************************
+# @copyright    : Siemens AG
+# @license      : GPLv3
+# @author       : Andreas Kaeberlein
+# @address      : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+#
+# @maintainer   : Andreas Kaeberlein
+# @telephone    : +49 371 4810-2108
+# @email        : andreas.kaeberlein@siemens.com
+#
+# @file         : fixture.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Synthetic sysfs and procfs
+#                 creates '<dir>/sys' and '<dir>/proc' with one root port
+#                 and one FPGA function 0000:01:00.0 (110a:4080), usable
+#                 with '--root=<dir>/sys --proc=<dir>/proc'
+#
+#                 fixture.sh <dir>
+# **********************************************************************/
+
+
+set -e
+
+# check args
+if [ -z "$1" ]; then
+    echo "Usage: $0 <dir>"
+    exit 1
+fi
+SYS="$1/sys"
+PROC="$1/proc"
+RP="$SYS/devices/pci0000:00/0000:00:01.0"
+DEV="$RP/0000:01:00.0"
+
+# root port
+mkdir -p "$RP"
+echo 0x8086 > "$RP/vendor"
+echo 0x1901 > "$RP/device"
+echo 0x060400 > "$RP/class"
+
+# FPGA function
+mkdir -p "$DEV/msi_irqs" "$DEV/power" "$DEV/link"
+echo 0x110a > "$DEV/vendor"
+echo 0x4080 > "$DEV/device"
+echo 0x110a > "$DEV/subsystem_vendor"
+echo 0x0001 > "$DEV/subsystem_device"
+echo 0x118000 > "$DEV/class"
+echo 0-1 > "$DEV/local_cpulist"
+echo -1 > "$DEV/numa_node"
+: > "$DEV/driver_override"
+touch "$DEV/msi_irqs/45" "$DEV/msi_irqs/46"
+echo auto > "$DEV/power/control"
+echo suspended > "$DEV/power/runtime_status"
+echo 0 > "$DEV/link/l0s_aspm"
+echo 1 > "$DEV/link/l1_aspm"
+echo 1 > "$DEV/link/clkpm"
+printf 'RxErr 0\nBadTLP 0\nBadDLLP 0\nRollover 0\nTimeout 0\nTOTAL_ERR_COR 0\n' > "$DEV/aer_dev_correctable"
+printf 'TOTAL_ERR_NONFATAL 0\n' > "$DEV/aer_dev_nonfatal"
+printf 'TOTAL_ERR_FATAL 0\n' > "$DEV/aer_dev_fatal"
+dd if=/dev/zero of="$DEV/resource0" bs=4096 count=1 2>/dev/null
+printf '\001\000\000\000\002\000\000\000' | dd of="$DEV/resource0" conv=notrunc 2>/dev/null
+
+# bus view, drivers and IOMMU group
+mkdir -p "$SYS/bus/pci/devices" "$SYS/bus/pci/drivers/uio_pci_generic" "$SYS/bus/pci/drivers/vfio-pci"
+mkdir -p "$SYS/kernel/iommu_groups/5" "$SYS/devices/system/cpu"
+ln -s ../../../devices/pci0000:00/0000:00:01.0 "$SYS/bus/pci/devices/0000:00:01.0"
+ln -s ../../../devices/pci0000:00/0000:00:01.0/0000:01:00.0 "$SYS/bus/pci/devices/0000:01:00.0"
+ln -s ../../../../bus/pci/drivers/uio_pci_generic "$DEV/driver"
+ln -s ../../../../kernel/iommu_groups/5 "$DEV/iommu_group"
+: > "$SYS/bus/pci/drivers/uio_pci_generic/unbind"
+: > "$SYS/bus/pci/drivers/vfio-pci/bind"
+echo 0-3 > "$SYS/devices/system/cpu/online"
+
+# interrupts, multi digit affinity to catch untruncated writes
+mkdir -p "$PROC/irq/45" "$PROC/irq/46"
+echo 0-3 > "$PROC/irq/45/smp_affinity_list"
+echo 0-3 > "$PROC/irq/46/smp_affinity_list"
+cat > "$PROC/interrupts" << EOF
+           CPU0       CPU1       CPU2       CPU3
+  0:         10          0          0          0   IO-APIC   2-edge      timer
+ 45:        100          3          0          0  PCI-MSI 524288-edge      vec0
+ 46:          0          0          0          0  PCI-MSI 524289-edge      vec1
+EOF
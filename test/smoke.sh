@@ -0,0 +1,60 @@
+#!/bin/sh
+# ***********************************************************************
+# @copyright    : Siemens AG
+# @license      : GPLv3
+# @author       : Andreas Kaeberlein
+# @address      : Clemens-Winkler-Strasse 3, 09116 Chemnitz
+#
+# @maintainer   : Andreas Kaeberlein
+# @telephone    : +49 371 4810-2108
+# @email        : andreas.kaeberlein@siemens.com
+#
+# @file         : smoke.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test
+#                 runs every 'smoke_<feature>.sh' against a fresh synthetic
+#                 tree of fixture.sh. The feature scripts are sourced and
+#                 use FIX, SYS, PROC, DEV, RUN, PCIINFO, PCIIDS and check().
+#
+#                 smoke.sh [<pciinfo> [<pciids>]]
+# **********************************************************************/
+
+
+PCIINFO="${1:-./bin/pciinfo}"
+PCIIDS="${2:-./bin/pciids}"
+TESTDIR="$(dirname "$0")"
+FAILS=0
+
+# check <name> <condition>
+check()
+{
+    if eval "$2" 2> /dev/null; then
+        echo "[ OKAY ]   $1"
+    else
+        echo "[ FAIL ]   $1"
+        FAILS=$((FAILS + 1))
+    fi
+}
+
+# one fixture per feature, directory name starts with 'pci' on purpose
+for TEST in "$TESTDIR"/smoke_*.sh; do
+    FIX="$(mktemp -d "${TMPDIR:-/tmp}/pcifix.XXXXXX")" || exit 1
+    trap 'rm -rf "$FIX"' EXIT
+    sh "$TESTDIR/fixture.sh" "$FIX" || exit 1
+    SYS="$FIX/sys"
+    PROC="$FIX/proc"
+    DEV="$SYS/devices/pci0000:00/0000:00:01.0/0000:01:00.0"
+    RUN="$PCIINFO --root=$SYS --proc=$PROC"
+    . "$TEST"
+    rm -rf "$FIX"
+done
+
+# summary
+if [ 0 -ne "$FAILS" ]; then
+    echo "[ FAIL ]   $FAILS checks failed"
+    exit 1
+fi
+echo "[ OKAY ]   all checks passed"
+exit 0
@@ -0,0 +1,39 @@
+# ***********************************************************************
+# @file         : smoke_aer.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test AER rates, alarm and counter reset, sourced by smoke.sh
+#                 the counters are changed while the 1 s window is open
+# **********************************************************************/
+
+
+# aer_cor <badtlp> <rollover> <total>
+aer_cor()
+{
+    printf 'RxErr 0\nBadTLP %s\nBadDLLP 0\nRollover %s\nTimeout 0\nTOTAL_ERR_COR %s\n' "$1" "$2" "$3" > "$DEV/aer_dev_correctable"
+}
+
+# samples
+OUT="$($RUN --aer=0 --aer-count=3)"
+check "aer: sample count" '[ "$(echo "$OUT" | grep -c "^aer .* bdf=0000:01:00.0 ")" = "3" ]'
+check "aer: watch count not used" '[ "$($RUN --aer=0 --aer-count=1 --count=5 | grep -c "^aer ")" = "1" ]'
+
+# rate and alarm
+(sleep 0.3; aer_cor 10 4 14) &
+OUT="$($RUN --aer=1000 --aer-count=1 --aer-max=1,1)"
+wait
+check "aer: correctable rate" 'echo "$OUT" | grep -q " cor=14 " && ! echo "$OUT" | grep -q " cor_ps=0.00 "'
+check "aer: bad TLP rate" '! echo "$OUT" | grep -q " badtlp_ps=0.00 "'
+check "aer: replay rate" '! echo "$OUT" | grep -q " replay_ps=0.00 "'
+check "aer: alarm above threshold" 'echo "$OUT" | grep -q " alarm=1 reset=0$"'
+(sleep 0.3; aer_cor 20 8 28) &
+OUT="$($RUN --aer=1000 --aer-count=1 --aer-max=1000,1000)"
+wait
+check "aer: no alarm below threshold" 'echo "$OUT" | grep -q " alarm=0 reset=0$" && ! echo "$OUT" | grep -q " badtlp_ps=0.00 "'
+
+# counter reset
+(sleep 0.3; aer_cor 0 0 0) &
+OUT="$($RUN --aer=1000 --aer-count=1 --aer-max=0,0)"
+wait
+check "aer: counter reset" 'echo "$OUT" | grep -q " cor=0 .* badtlp_ps=0.00 alarm=0 reset=1$"'
@@ -0,0 +1,22 @@
+# ***********************************************************************
+# @file         : smoke_bar.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test BAR dump, diff and restore on resource0, sourced by smoke.sh
+# **********************************************************************/
+
+
+# dump -> change -> diff -> restore -> diff
+OUT="$($RUN --dump=0 --image="$FIX/bar.img" --brief)"
+check "bar: dump" 'echo "$OUT" | grep -q "^PCIINFO_DUMP_BYTES=4096$" && cmp -s "$FIX/bar.img" "$DEV/resource0"'
+printf '\377' | dd of="$DEV/resource0" bs=1 seek=100 conv=notrunc 2> /dev/null
+printf '\377' | dd of="$DEV/resource0" bs=1 seek=4000 conv=notrunc 2> /dev/null
+check "bar: diff after change" '$RUN --diff=0 --image="$FIX/bar.img" --brief | grep -q "^PCIINFO_DIFF_LINES=2$"'
+$RUN --restore=0 --image="$FIX/bar.img" > /dev/null
+check "bar: restored" 'cmp -s "$FIX/bar.img" "$DEV/resource0"'
+check "bar: diff after restore" '$RUN --diff=0 --image="$FIX/bar.img" --brief | grep -q "^PCIINFO_DIFF_LINES=0$"'
+
+# errors
+check "bar: unaligned range rejected" '! $RUN --dump=0:0x8:0x4 --image="$FIX/odd.img" > /dev/null && [ ! -e "$FIX/odd.img" ]'
+check "bar: partial image removed" '! (trap "" XFSZ; ulimit -f 1; $RUN --dump=0 --image="$FIX/part.img" > /dev/null) && [ ! -e "$FIX/part.img" ]'
@@ -0,0 +1,17 @@
+# ***********************************************************************
+# @file         : smoke_bind.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test driver bind and IOMMU group, sourced by smoke.sh
+# **********************************************************************/
+
+
+OUT="$($RUN --bind=vfio-pci --brief)"
+check "bind: no error" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_0_ERR=0$"'
+check "bind: IOMMU group" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_0_IOMMU=5$"'
+check "bind: unbind old driver" 'grep -q "0000:01:00.0" "$SYS/bus/pci/drivers/uio_pci_generic/unbind"'
+check "bind: driver override" 'grep -q "^vfio-pci" "$DEV/driver_override"'
+check "bind: bind new driver" 'grep -q "0000:01:00.0" "$SYS/bus/pci/drivers/vfio-pci/bind"'
+check "bind: BDF filter match" '$RUN --bdf=0000:01 --iommu --brief | grep -q "^PCIINFO_110A_4080_0_BDF=\"0000:01:00.0\"$"'
+check "bind: BDF filter no match" '! $RUN --bdf=0000:02 --iommu --brief | grep -q "_0_BDF="'
@@ -0,0 +1,12 @@
+# ***********************************************************************
+# @file         : smoke_dma.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test DMA buffer arguments, sourced by smoke.sh
+#                 allocation itself needs reserved hugepages and root
+# **********************************************************************/
+
+
+check "dma: small pages rejected" '! $RUN --dma=0x1000:0x1000 > /dev/null'
+check "dma: odd page size rejected" '! $RUN --dma=0x200000:0x300000 > /dev/null'
@@ -0,0 +1,34 @@
+# ***********************************************************************
+# @file         : smoke_fanout.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test parallel register read, sourced by smoke.sh
+#                 adds 0000:02:00.0 with an unmappable BAR2 and 0000:01:00.1
+#                 without BAR0, created against BDF order
+# **********************************************************************/
+
+
+# fanout_dev <bdf> <parent>
+fanout_dev()
+{
+    mkdir -p "$SYS/devices/$2/$1"
+    echo 0x110a > "$SYS/devices/$2/$1/vendor"
+    echo 0x4080 > "$SYS/devices/$2/$1/device"
+    echo 0x118000 > "$SYS/devices/$2/$1/class"
+    ln -s "../../../devices/$2/$1" "$SYS/bus/pci/devices/$1"
+}
+fanout_dev 0000:02:00.0 pci0000:00/0000:00:02.0
+dd if=/dev/zero of="$SYS/devices/pci0000:00/0000:00:02.0/0000:02:00.0/resource0" bs=4096 count=1 2> /dev/null
+printf '\007\000\000\000' | dd of="$SYS/devices/pci0000:00/0000:00:02.0/0000:02:00.0/resource0" bs=1 seek=4 conv=notrunc 2> /dev/null
+: > "$SYS/devices/pci0000:00/0000:00:02.0/0000:02:00.0/resource2"
+fanout_dev 0000:01:00.1 pci0000:00/0000:00:01.0
+
+OUT="$($RUN --fanout=0:0x4 --threads=3 --brief)"
+check "fanout: BDF order" '[ "$(echo "$OUT" | grep "_BDF=" | tr "\n" " ")" = "PCIINFO_110A_4080_0_BDF=\"0000:01:00.0\" PCIINFO_110A_4080_1_BDF=\"0000:01:00.1\" PCIINFO_110A_4080_2_BDF=\"0000:02:00.0\" " ]'
+check "fanout: register" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_0_REG=0x00000002$" && echo "$OUT" | grep -q "^PCIINFO_110A_4080_0_ERR=0$"'
+check "fanout: only selected BAR mapped" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_2_REG=0x00000007$" && echo "$OUT" | grep -q "^PCIINFO_110A_4080_2_ERR=0$"'
+check "fanout: missing BAR errno" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_1_ERR=-2$"'
+check "fanout: failure exit code" '! $RUN --fanout=0:0x4 --brief > /dev/null'
+check "fanout: BDF filter" '$RUN --fanout=0:0x4 --bdf=0000:02 --brief > /dev/null'
+check "fanout: unmappable BAR errno" '$RUN --fanout=2:0x0 --bdf=0000:02 --brief | grep -q "^PCIINFO_110A_4080_0_ERR=-22$"'
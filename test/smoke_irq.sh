@@ -0,0 +1,16 @@
+# ***********************************************************************
+# @file         : smoke_irq.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test interrupt vectors and spreading, sourced by smoke.sh
+# **********************************************************************/
+
+
+OUT="$($RUN --irq=0 --brief)"
+check "irq: vectors" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_IRQ_1=46$"'
+check "irq: affinity" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_IRQ_0_CPUS=\"0-3\"$"'
+check "irq: per CPU counts" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_IRQ_0_CPU_COUNT=\"0:100 1:3\"$"'
+OUT="$($RUN --irq-spread --irq=0 --brief)"
+check "irq: spread over local CPUs" '[ "$(cat "$PROC/irq/45/smp_affinity_list")" = "0" ] && [ "$(cat "$PROC/irq/46/smp_affinity_list")" = "1" ]'
+check "irq: spread read back" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_IRQ_1_CPUS=\"1\"$"'
@@ -0,0 +1,34 @@
+# ***********************************************************************
+# @file         : smoke_names.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test PCI names database, sourced by smoke.sh
+# **********************************************************************/
+
+
+printf '# vendors\n110a  Siemens AG\n\t4080  FPGA Card\n\t\t110a 0001  Test Board\nC 01  Mass storage controller\n\t00  SCSI\n' > "$FIX/pci.ids"
+$PCIIDS "$FIX/pci.ids" "$FIX/pci.ids.bin" > /dev/null
+check "names: compiled" '[ -s "$FIX/pci.ids.bin" ] && [ "$(head -c 8 "$FIX/pci.ids.bin")" = "PCIIDB01" ]'
+check "names: no temporary file left" '[ -z "$(ls "$FIX" | grep "pci.ids.bin.")" ]'
+check "names: tree" '$RUN --names="$FIX/pci.ids.bin" --tree | grep -q "0000:01:00.0 \[110a:4080\] Siemens AG FPGA Card$"'
+OUT="$($RUN --names="$FIX/pci.ids.bin" --brief)"
+check "names: subsystem" 'echo "$OUT" | grep -q "^PCIINFO_110A_4080_SUBSYS=\"Test Board\"$"'
+
+# corrupt databases
+cp "$FIX/pci.ids.bin" "$FIX/magic.bin"
+printf 'X' | dd of="$FIX/magic.bin" conv=notrunc 2> /dev/null
+check "names: bad magic rejected" '! $RUN --names="$FIX/magic.bin" --tree > /dev/null'
+cp "$FIX/pci.ids.bin" "$FIX/offset.bin"
+SLOTS="$(od -An -tu4 -j8 -N4 "$FIX/offset.bin" | tr -d " ")"
+I=0
+while [ "$I" -lt "$SLOTS" ]; do
+    printf '\377\377\377\177' | dd of="$FIX/offset.bin" bs=1 seek=$((24 + 16 * I + 12)) conv=notrunc 2> /dev/null
+    I=$((I + 1))
+done
+check "names: offset outside blob ignored" '$RUN --names="$FIX/offset.bin" --tree | grep -q "0000:01:00.0 \[110a:4080\]$"'
+
+# empty database keeps the previous one
+printf '# comment only\n' > "$FIX/empty.ids"
+check "names: empty input fails" '! $PCIIDS "$FIX/empty.ids" "$FIX/pci.ids.bin" > /dev/null'
+check "names: previous database kept" '$RUN --names="$FIX/pci.ids.bin" --tree | grep -q "Siemens AG FPGA Card$"'
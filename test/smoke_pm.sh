@@ -0,0 +1,21 @@
+# ***********************************************************************
+# @file         : smoke_pm.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test power management save and restore, sourced by smoke.sh
+# **********************************************************************/
+
+
+$RUN --pm-on="$FIX/pm.state" > /dev/null
+check "pm-on: control on" '[ "$(cat "$DEV/power/control")" = "on" ]'
+check "pm-on: ASPM L1 off" '[ "$(cat "$DEV/link/l1_aspm")" = "0" ]'
+check "pm-on: clock PM off" '[ "$(cat "$DEV/link/clkpm")" = "0" ]'
+check "pm-on: saved state" 'grep -q "^0000:01:00.0 auto 0 1 -1 -1 1$" "$FIX/pm.state"'
+check "pm-on: keeps saved state" '! $RUN --pm-on="$FIX/pm.state" > /dev/null && grep -q " auto " "$FIX/pm.state"'
+$RUN --pm-restore="$FIX/pm.state" > /dev/null
+check "pm-restore: control auto" '[ "$(cat "$DEV/power/control")" = "auto" ]'
+check "pm-restore: ASPM L1 on" '[ "$(cat "$DEV/link/l1_aspm")" = "1" ]'
+check "pm-restore: clock PM on" '[ "$(cat "$DEV/link/clkpm")" = "1" ]'
+check "pm-restore: state consumed" '[ ! -e "$FIX/pm.state" ]'
+check "pm-restore: missing state fails" '! $RUN --pm-restore="$FIX/pm.state" > /dev/null'
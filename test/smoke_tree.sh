@@ -0,0 +1,22 @@
+# ***********************************************************************
+# @file         : smoke_tree.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test topology and distance, sourced by smoke.sh
+# **********************************************************************/
+
+
+# second hierarchy
+mkdir -p "$SYS/devices/pci0000:80/0000:80:02.0"
+echo 0x8086 > "$SYS/devices/pci0000:80/0000:80:02.0/vendor"
+echo 0x2030 > "$SYS/devices/pci0000:80/0000:80:02.0/device"
+ln -s ../../../devices/pci0000:80/0000:80:02.0 "$SYS/bus/pci/devices/0000:80:02.0"
+
+OUT="$($RUN --tree)"
+check "tree: root complex" 'echo "$OUT" | grep -q "^ *pci0000:00$"'
+check "tree: second root complex" 'echo "$OUT" | grep -q "^ *pci0000:80$"'
+check "tree: device below root port" 'echo "$OUT" | grep -q "^ *+- 0000:01:00.0 \[110a:4080\]$"'
+check "tree: no sysroot as root complex" '! echo "$OUT" | grep -q "pcifix"'
+check "tree: distance over host" '$RUN --dist=0000:80:02.0 | grep -q "hops via host"'
+check "tree: distance over root port" '$RUN --dist=0000:00:01.0 | grep -q "1 hops via 0000:00:01.0"'
@@ -0,0 +1,17 @@
+# ***********************************************************************
+# @file         : smoke_watch.sh
+# @date         : 2026-10-18
+# @see          : https://github.com/andkae/pciinfo
+#
+# @brief        : Smoke test register watch on resource0 stand-in, sourced by smoke.sh
+# **********************************************************************/
+
+
+OUT="$($PCIINFO --watch=0:0x0,0x4 --file="$DEV/resource0" --count=100 --rate=0 --trace="$FIX/watch.trace" --brief)"
+check "watch: samples" 'echo "$OUT" | grep -q "^PCIINFO_WATCH_SAMPLED=100$"'
+check "watch: no drops" 'echo "$OUT" | grep -q "^PCIINFO_WATCH_DROPPED=0$"'
+check "watch: trace magic" '[ "$(head -c 8 "$FIX/watch.trace")" = "PCIWTR01" ]'
+check "watch: unaligned offset rejected" '! $PCIINFO --watch=0:0x2 --file="$DEV/resource0" --count=1 --trace="$FIX/watch.trace" > /dev/null'
+check "watch: rate above 1 GHz rejected" '! $PCIINFO --watch=0:0x0 --file="$DEV/resource0" --count=1 --rate=2000000000 --trace="$FIX/watch.trace" > /dev/null'
+OUT="$($PCIINFO --watch=0:0x0 --file="$DEV/resource0" --count=20 --rate=1000 --trace="$FIX/watch.trace" --brief)"
+check "watch: rate limited samples" 'echo "$OUT" | grep -q "^PCIINFO_WATCH_SAMPLED=20$"'